@@ -3,5 +3,5 @@
 mkdir -p build
 cd build
 cmake -DCMAKE_BUILD_TYPE=Debug ..
-make
+make pokerbot
 cd ..
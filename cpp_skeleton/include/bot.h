@@ -0,0 +1,365 @@
+#pragma once
+
+#include <skeleton/actions.h>
+#include <skeleton/buckets.h>
+#include <skeleton/cfr.h>
+#include <skeleton/constants.h>
+#include <skeleton/endgame.h>
+#include <skeleton/equity.h>
+#include <skeleton/features.h>
+#include <skeleton/opponent_model.h>
+#include <skeleton/preflop_equity.h>
+#include <skeleton/random.h>
+#include <skeleton/runner.h>
+#include <skeleton/showdown_history.h>
+#include <skeleton/states.h>
+#include <skeleton/strategy_table.h>
+#include <skeleton/thread_pool.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+inline int rankOfCard(std::uint32_t card)
+{
+    return static_cast<int>((card >> 8) & 0xF);
+}
+
+class Card
+{
+public:
+    std::uint32_t code;
+
+    Card() : code(0) {}
+    explicit Card(std::uint32_t c) : code(c) {}
+
+    // Rank index: 0..12 (Deuce..Ace)
+    int rank() const
+    {
+        return rankOfCard(code);
+    }
+
+    //   0x8000 -> clubs, 0x4000 -> diamonds, 0x2000 -> hearts, 0x1000 -> spades
+    char suitChar() const
+    {
+        if (code & 0x8000)
+            return 'c';
+        else if (code & 0x4000)
+            return 'd';
+        else if (code & 0x2000)
+            return 'h';
+        else
+            return 's';
+    }
+
+    // Convert rank index to char representation: 2..9, T, J, Q, K, A
+    char rankChar() const
+    {
+        static const char rankChars[] = {'2', '3', '4', '5', '6', '7', '8', '9', 'T', 'J', 'Q', 'K', 'A'};
+        return rankChars[rank()];
+    }
+
+    void print() const
+    {
+        std::cout << rankChar() << suitChar();
+    }
+};
+
+class Deck
+{
+private:
+    std::vector<Card> cards_;
+    pokerbots::skeleton::Rng rng_;
+
+public:
+    Deck() : Deck(pokerbots::skeleton::Rng(pokerbots::skeleton::masterSeed()))
+    {
+    }
+
+    explicit Deck(pokerbots::skeleton::Rng rng) : rng_(rng)
+    {
+        init();
+    }
+
+    void init()
+    {
+        cards_.resize(52);
+
+        // suits in original code: clubs=0x8000, diamonds=0x4000,
+        //                        hearts=0x2000, spades=0x1000
+        int index = 0;
+        for (int s = 0; s < 4; ++s)
+        {
+            for (int r = 0; r < 13; ++r)
+            {
+                cards_[index++] = Card(pokerbots::skeleton::CARD_CODES[pokerbots::skeleton::cardIndex(r, s)]);
+            }
+        }
+    }
+
+    // Shuffle using <algorithm>'s std::shuffle
+    void shuffle()
+    {
+        std::shuffle(cards_.begin(), cards_.end(), rng_);
+    }
+
+    // Access
+    Card &operator[](std::size_t i) { return cards_[i]; }
+    const Card &operator[](std::size_t i) const { return cards_[i]; }
+
+    std::size_t size() const { return cards_.size(); }
+};
+
+/*
+  The bot's state and decisions. Definitions live in src/bot.cpp, which the
+  pokerbot and the offline tools that drive the bot link against.
+*/
+struct Bot
+{
+
+    int totalRounds = 1;
+    int timesBetPreflop = 0;
+
+    Deck deckInstance;
+
+    bool alreadyWon = false;
+
+    int numMCTrials = 600;
+    int oppHandsPerRunout = 2; // the fewest HS^2 allows, so the samples stay close to the independent draws thresholds were tuned on
+    int maxFeatureBatches = 4; // decisions on one board that still add samples
+
+    pokerbots::skeleton::Rng rng;
+    pokerbots::skeleton::HandFeatures handFeatures;
+    // this round's feature counts, refined by each decision and filled ahead by speculation while the opponent acts
+    pokerbots::skeleton::FeatureMemo featureMemo;
+    pokerbots::skeleton::ActionSamples actionSamples;
+    pokerbots::skeleton::BucketTable bucketTable;
+    pokerbots::skeleton::PreflopEquity preflopEquity;
+    std::vector<int> preflopOrder; // combos from strongest to weakest by regularPreflopDict
+    pokerbots::skeleton::StrategyTable strategyTable;
+    std::unique_ptr<pokerbots::skeleton::CardAbstraction> strategyCards;
+    std::unique_ptr<pokerbots::skeleton::TreeCursor> blueprintCursor; // this round's node in the blueprint's tree
+    pokerbots::skeleton::ThreadPool workers;
+    pokerbots::skeleton::OpponentModel opponentModel;
+    std::string opponentProfilePath;
+    std::future<bool> opponentProfileLoad;
+
+    int numOppChecks = 0;
+    int numSelfChecks = 0;
+    int oppLastContribution = 0;
+
+    double raiseFactor = 0.05;
+    double reRaiseFactor = 0.025;
+
+    bool hasBounty = false;
+    int bountyRaises = 0;
+    bool alarmBell = false;
+
+    bool nitToggle = true; // think reversely
+    bool looseToggle = false;
+
+    bool oppReRaiseAsBBMore = true;
+    bool oppRaiseAsDealerLess = true;
+
+    bool twoCheckBluff = false;
+    int pmTwoCheckBluff = 0;
+    bool threeCheckBluff = false;
+    int pmThreeCheckBluff = 0;
+    bool bountyBluff = false;
+    int pmBountyBluff = 0;
+
+    bool permanentNoTwoCheck = false;
+    int twoCheckBluffCounter = 0;
+    bool permanentNoThreeCheck = false;
+    int threeCheckBluffCounter = 0;
+    bool permanentNoBountyBluff = false;
+    int bountyBluffCounter = 0;
+
+    bool oppBetLastRound = false;
+
+    int unnitBigBetFact = 0;
+    int bluffCatcherFact = 0;
+    int oppReraiseFact = 0;
+
+    int oppNumReraise = 0;
+    int oppNumBetsThisRound = 0;
+    int ourRaisesThisRound = 0;
+    int ourReRaisesThisRound = 0;
+    int bbPipThreshold = 12;
+
+    pokerbots::skeleton::FoldOutOdds foldOutOdds;
+    double lockInConfidence = 0.9999; // fold out once that sure of winning the match
+
+    int lastStreet = -1;
+
+    bool aggressiveMode = false;
+
+    bool oppCheckFold = false;
+
+    bool reraiseLess = false;
+    bool shoveTime = false;
+    bool autoFold = false;
+
+    std::unordered_map<std::string, int> regularPreflopDict = {
+        {"AAo", 1}, {"KKo", 2}, {"QQo", 3}, {"JJo", 4}, {"TTo", 5}, {"99o", 10}, {"88o", 10}, {"AKs", 6}, {"77o", 11}, {"AQs", 9}, {"AJs", 11}, 
+        {"AKo", 6}, {"ATs", 13}, {"AQo", 14}, {"AJo", 15}, {"KQs", 16}, {"KJs", 17}, {"A9s", 18}, {"ATo", 19}, {"66o", 20}, {"A8s", 21}, {"KTs", 22}, 
+        {"KQo", 23}, {"A7s", 24}, {"A9o", 25}, {"KJo", 26}, {"55o", 27}, {"QJs", 28}, {"K9s", 29}, {"A5s", 30}, {"A6s", 31}, {"A8o", 32}, {"KTo", 33}, 
+        {"QTs", 34}, {"A4s", 35}, {"A7o", 36}, {"K8s", 37}, {"A3s", 38}, {"QJo", 39}, {"K9o", 40}, {"A5o", 41}, {"A6o", 42}, {"Q9s", 43}, {"K7s", 44}, 
+        {"JTs", 45}, {"A2s", 46}, {"QTo", 47}, {"44o", 48}, {"A4o", 49}, {"K6s", 50}, {"K8o", 51}, {"Q8s", 52}, {"A3o", 53}, {"K5s", 54}, {"J9s", 55}, 
+        {"Q9o", 56}, {"JTo", 57}, {"K7o", 58}, {"A2o", 59}, {"K4s", 60}, {"Q7s", 61}, {"K6o", 62}, {"K3s", 63}, {"T9s", 64}, {"J8s", 65}, {"33o", 66}, 
+        {"Q6s", 67}, {"Q8o", 68}, {"K5o", 69}, {"J9o", 70}, {"K2s", 71}, {"Q5s", 72}, {"T8s", 73}, {"K4o", 74}, {"J7s", 75}, {"Q4s", 76}, {"Q7o", 77}, 
+        {"T9o", 78}, {"J8o", 79}, {"K3o", 80}, {"Q6o", 81}, {"Q3s", 82}, {"98s", 83}, {"T7s", 84}, {"J6s", 85}, {"K2o", 86}, {"22o", 87}, {"Q2s", 87}, 
+        {"Q5o", 89}, {"J5s", 90}, {"T8o", 91}, {"J7o", 92}, {"Q4o", 93}, {"97s", 80}, {"J4s", 95}, {"T6s", 96}, {"J3s", 97}, {"Q3o", 98}, {"98o", 99}, 
+        {"87s", 85}, {"T7o", 101}, {"J6o", 102}, {"96s", 103}, {"J2s", 104}, {"Q2o", 105}, {"T5s", 106}, {"J5o", 107}, {"T4s", 108}, {"97o", 109}, 
+        {"86s", 110}, {"J4o", 111}, {"T6o", 112}, {"95s", 113}, {"T3s", 114}, {"76s", 90}, {"J3o", 116}, {"87o", 117}, {"T2s", 118}, {"85s", 119}, 
+        {"96o", 120}, {"J2o", 121}, {"T5o", 122}, {"94s", 123}, {"75s", 124}, {"T4o", 125}, {"93s", 126}, {"86o", 127}, {"65s", 128}, {"84s", 129}, 
+        {"95o", 130}, {"53s", 131}, {"92s", 132}, {"76o", 133}, {"74s", 134}, {"65o", 135}, {"54s", 130}, {"85o", 137}, {"64s", 138}, {"83s", 139}, 
+        {"43s", 140}, {"75o", 141}, {"82s", 142}, {"73s", 143}, {"93o", 144}, {"T2o", 145}, {"T3o", 146}, {"63s", 147}, {"84o", 148}, {"92o", 149}, 
+        {"94o", 150}, {"74o", 151}, {"72s", 152}, {"54o", 153}, {"64o", 154}, {"52s", 155}, {"62s", 156}, {"83o", 157}, {"42s", 158}, {"82o", 159}, 
+        {"73o", 160}, {"53o", 161}, {"63o", 162}, {"32s", 163}, {"43o", 164}, {"72o", 165}, {"52o", 166}, {"62o", 167}, {"42o", 168}, {"32o", 169}};
+
+    std::unordered_map<std::string, int> aggPreflopDict = {
+        {"AAo", 1}, {"KKo", 2}, {"QQo", 3}, {"JJo", 4}, {"TTo", 5}, {"99o", 10}, {"88o", 10}, {"AKs", 6}, {"77o", 11}, {"AQs", 9}, {"AJs", 11}, 
+        {"AKo", 6}, {"ATs", 13}, {"AQo", 14}, {"AJo", 15}, {"KQs", 16}, {"KJs", 27}, {"A9s", 18}, {"ATo", 19}, {"66o", 20}, {"A8s", 21}, {"KTs", 27}, 
+        {"KQo", 23}, {"A7s", 24}, {"A9o", 25}, {"KJo", 27}, {"55o", 25}, {"QJs", 27}, {"K9s", 25}, {"A5s", 25}, {"A6s", 25}, {"A8o", 25}, {"KTo", 25}, 
+        {"QTs", 34}, {"A4s", 25}, {"A7o", 25}, {"K8s", 37}, {"A3s", 25}, {"QJo", 39}, {"K9o", 40}, {"A5o", 25}, {"A6o", 25}, {"Q9s", 43}, {"K7s", 44}, 
+        {"JTs", 45}, {"A2s", 25}, {"QTo", 47}, {"44o", 25}, {"A4o", 25}, {"K6s", 50}, {"K8o", 51}, {"Q8s", 52}, {"A3o", 25}, {"K5s", 54}, {"J9s", 55}, 
+        {"Q9o", 56}, {"JTo", 57}, {"K7o", 58}, {"A2o", 25}, {"K4s", 60}, {"Q7s", 61}, {"K6o", 62}, {"K3s", 63}, {"T9s", 64}, {"J8s", 65}, {"33o", 25}, 
+        {"Q6s", 67}, {"Q8o", 68}, {"K5o", 69}, {"J9o", 70}, {"K2s", 71}, {"Q5s", 72}, {"T8s", 73}, {"K4o", 74}, {"J7s", 75}, {"Q4s", 76}, {"Q7o", 77}, 
+        {"T9o", 78}, {"J8o", 79}, {"K3o", 80}, {"Q6o", 81}, {"Q3s", 82}, {"98s", 83}, {"T7s", 84}, {"J6s", 85}, {"K2o", 86}, {"22o", 25}, {"Q2s", 87}, 
+        {"Q5o", 89}, {"J5s", 90}, {"T8o", 91}, {"J7o", 92}, {"Q4o", 93}, {"97s", 80}, {"J4s", 95}, {"T6s", 96}, {"J3s", 97}, {"Q3o", 98}, {"98o", 99}, 
+        {"87s", 85}, {"T7o", 101}, {"J6o", 102}, {"96s", 103}, {"J2s", 104}, {"Q2o", 105}, {"T5s", 106}, {"J5o", 107}, {"T4s", 108}, {"97o", 109}, 
+        {"86s", 110}, {"J4o", 111}, {"T6o", 112}, {"95s", 113}, {"T3s", 114}, {"76s", 90}, {"J3o", 116}, {"87o", 117}, {"T2s", 118}, {"85s", 119}, 
+        {"96o", 120}, {"J2o", 121}, {"T5o", 122}, {"94s", 123}, {"75s", 124}, {"T4o", 125}, {"93s", 126}, {"86o", 127}, {"65s", 128}, {"84s", 129}, 
+        {"95o", 130}, {"53s", 131}, {"92s", 132}, {"76o", 133}, {"74s", 134}, {"65o", 135}, {"54s", 130}, {"85o", 137}, {"64s", 138}, {"83s", 139}, 
+        {"43s", 140}, {"75o", 141}, {"82s", 142}, {"73s", 143}, {"93o", 144}, {"T2o", 145}, {"T3o", 146}, {"63s", 147}, {"84o", 148}, {"92o", 149}, 
+        {"94o", 150}, {"74o", 151}, {"72s", 152}, {"54o", 153}, {"64o", 154}, {"52s", 155}, {"62s", 156}, {"83o", 157}, {"42s", 158}, {"82o", 159}, 
+        {"73o", 160}, {"53o", 161}, {"63o", 162}, {"32s", 163}, {"43o", 164}, {"72o", 165}, {"52o", 166}, {"62o", 167}, {"42o", 168}, {"32o", 169}};
+
+
+    // resolves stop after this many iterations rather than against the clock when set, for reproducible replays
+    int fixedResolveIterations = 0;
+
+    // every random choice derives from seed, one stream per use, so a fixed POKERBOT_SEED replays a match exactly
+    // stratified runouts: about half the random variance on the turn and a fifth less on the flop at the same cost (tools/sampling)
+    explicit Bot(std::uint64_t seed = pokerbots::skeleton::masterSeed());
+
+    /*
+      Called when a new round starts. Called NUM_ROUNDS times.
+
+      @param gameState The GameState object.
+      @param roundState The RoundState object.
+      @param active Your player's index.
+    */
+    void handleNewRound(pokerbots::skeleton::GameInfoPtr gameState, pokerbots::skeleton::RoundStatePtr roundState, int active);
+
+    /*
+      Called when the opponent's cards are revealed at showdown, before handleRoundOver.
+
+      @param gameState The GameState object.
+      @param record The showdown as the runner recorded it.
+      @param active Your player's index.
+    */
+    void handleShowdown(pokerbots::skeleton::GameInfoPtr gameState, const pokerbots::skeleton::ShowdownRecord &record, int active);
+
+    /*
+      Sets the bot's reads on the opponent from the opponent model.
+    */
+    void refreshOpponentReads();
+
+    /*
+      Called when a round ends. Called NUM_ROUNDS times.
+
+      @param gameState The GameState object.
+      @param terminalState The TerminalState object.
+      @param active Your player's index.
+    */
+    void handleRoundOver(pokerbots::skeleton::GameInfoPtr gameState, pokerbots::skeleton::TerminalStatePtr terminalState, int active);
+
+    /*
+      Called once the match is over.
+
+      @param gameState The GameState object.
+    */
+    void handleGameOver(pokerbots::skeleton::GameInfoPtr gameState);
+
+    int get_rank_index(char rank);
+
+    std::string categorize_cards(const std::vector<std::string> &cards);
+
+    // All-in equity of our hole cards against the strongest `share` of combos by the preflop ranking, from the precomputed table.
+    double preflopEquityAgainst(const std::vector<std::string> &cards, double share);
+
+    int noIllegalRaises(int myBet, pokerbots::skeleton::RoundStatePtr roundState, bool active);
+
+    pokerbots::skeleton::Action getPreflopAction(pokerbots::skeleton::RoundStatePtr roundState, int active);
+
+    std::pair<pokerbots::skeleton::Action, int> getPostflopAction(double handStrength, double rangeEquity, pokerbots::skeleton::RoundStatePtr roundState, int active);
+
+    /*
+      Prices putting our pip for this street at `amount`: a raise if it is above the opponent's pip, a call or
+      check otherwise. The opponent defends a raise with the minimum defence frequency.
+    */
+    pokerbots::skeleton::Candidate candidateAt(pokerbots::skeleton::RoundStatePtr roundState, int active, int amount);
+
+    /*
+      The pip amount worth most among `amounts`, all valued on the same samples drawn for this decision, so
+      that the comparison is not swamped by sampling noise. Returns the first amount if there are no samples.
+    */
+    int bestAmount(pokerbots::skeleton::RoundStatePtr roundState, int active, const std::vector<int> &amounts);
+
+    /*
+      The raise among `amounts` worth most against the opponent's range, on the turn or river where every runout
+      can be enumerated. The opponent calls with the combos whose equity against a random hand beats the price,
+      and each call is settled at our exact equity against that combo.
+    */
+    int bestRangeAmount(pokerbots::skeleton::RoundStatePtr roundState, int active, const std::vector<int> &amounts, const pokerbots::skeleton::Range &villainRange);
+
+    // The best of three raises between low and high times the pot; exactly against villainRange when there is one.
+    int bestRaiseSize(pokerbots::skeleton::RoundStatePtr roundState, int active, int pot, double low, double high, const pokerbots::skeleton::Range *villainRange);
+
+    /*
+      Narrows range, filled uniformly first, to what the opponent's check or bet on this street holds. Only the turn
+      and river are narrowed, once the opponent has acted on the street; returns whether the range was changed.
+    */
+    bool estimateVillainRange(pokerbots::skeleton::RoundStatePtr roundState, int active, pokerbots::skeleton::Range &range);
+
+    // The seconds a turn or river decision may spend: a share of the clock left per remaining round, capped.
+    double decisionSeconds(pokerbots::skeleton::GameInfoPtr gameState);
+
+    /*
+      Re-solves the rest of this street against villainRange for up to `seconds` and samples a raise size from the
+      solution's raising actions. Returns nothing if the solve did not converge far enough or it (almost) never raises.
+    */
+    std::optional<int> getResolvedBetSize(pokerbots::skeleton::RoundStatePtr roundState, int active, const pokerbots::skeleton::Range &villainRange, double seconds);
+
+    int getPostflopBetSize(double handStrength, pokerbots::skeleton::GameInfoPtr gameState, pokerbots::skeleton::RoundStatePtr roundState, int active, int actionCategory);
+
+    /*
+      Called between our action and the next packet with the state our action led to. Whatever the
+      opponent does next either leaves the board as it is or deals the next card, so this samples
+      the features of the current board and of every possible next card, one board per call.
+      River boards are analysed exactly when we act, so there is nothing to sample ahead for them.
+      Returns whether there is more to do.
+    */
+    bool handleIdle(pokerbots::skeleton::GameInfoPtr gameState, pokerbots::skeleton::RoundStatePtr roundState, int active);
+
+    /*
+      Looks the current situation up in the blueprint strategy and samples an action from it.
+      Returns nothing if there is no table, which is only loaded when POKERBOT_BLUEPRINT opts in,
+      or the betting has left the abstract tree.
+    */
+    std::optional<pokerbots::skeleton::Action> getBlueprintAction(pokerbots::skeleton::RoundStatePtr roundState, int active);
+
+    // The preflop and postflop strategies with their bookkeeping.
+    pokerbots::skeleton::Action getHandTunedAction(pokerbots::skeleton::GameInfoPtr gameState, pokerbots::skeleton::RoundStatePtr roundState, int active);
+
+    pokerbots::skeleton::Action getAction(pokerbots::skeleton::GameInfoPtr gameState, pokerbots::skeleton::RoundStatePtr roundState, int active);
+};
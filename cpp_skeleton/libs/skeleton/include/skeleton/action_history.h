@@ -0,0 +1,82 @@
+#pragma once
+
+#include "states.h"
+
+namespace pokerbots::skeleton {
+
+namespace detail {
+
+// Replays the actions after `since`, or all of them for a null `since`; false if `since` is not on the chain.
+template <typename Visit>
+bool replayChain(const RoundState &state, const RoundState *since, bool &closedByCall, Visit &visit) {
+  if (&state == since) {
+    return true;
+  }
+  auto previous = dynamic_cast<const RoundState *>(state.previousState.get());
+  if (!previous) {
+    return !state.previousState && !since;
+  }
+  if (!replayChain(*previous, since, closedByCall, visit)) {
+    return false;
+  }
+  if (state.street != previous->street && closedByCall) {
+    // a call is recorded on its own state before the next street is dealt
+    closedByCall = false;
+    return true;
+  }
+  auto actor = getActive(previous->button);
+  auto action = Action::Type::CHECK;
+  if (state.street == previous->street && state.pips[actor] > previous->pips[actor]) {
+    action = state.pips[actor] == previous->pips[1 - actor] ? Action::Type::CALL : Action::Type::RAISE;
+  }
+  // calling the big blind preflop does not close the street
+  closedByCall = action == Action::Type::CALL && !(previous->street == 0 && previous->button == 0);
+  visit(*previous, &state, action);
+  return true;
+}
+
+} // namespace detail
+
+/*
+  Calls visit(before, after, action) for every action that led to `state`,
+  oldest first, reading them off the states the runner linked through
+  previousState. A raise is to after->pips of the player who made it. Returns
+  false if the chain holds anything but round states.
+*/
+template <typename Visit>
+bool forEachAction(const RoundState &state, Visit visit) {
+  bool closedByCall = false;
+  return detail::replayChain(state, nullptr, closedByCall, visit);
+}
+
+/*
+  Only the actions between `since`, an earlier state of the same round or null
+  for its start, and `state`. closedByCall carries whether the action into
+  `since` was a call that closed its street, false at the start of the round,
+  and is updated for the next call. Returns false without visiting anything
+  if `since` is not on the chain.
+*/
+template <typename Visit>
+bool forEachActionSince(const RoundState *since, const RoundState &state, bool &closedByCall, Visit visit) {
+  // nothing is visited and closedByCall is left alone until the walk has found `since`
+  return detail::replayChain(state, since, closedByCall, visit);
+}
+
+/*
+  The same for a finished round. The last action leaves no state behind when
+  it is a fold or the check that ends the river; it is visited with a null
+  `after`.
+*/
+template <typename Visit>
+void forEachAction(const TerminalState &terminal, Visit visit) {
+  auto last = dynamic_cast<const RoundState *>(terminal.previousState.get());
+  bool closedByCall = false;
+  if (!last || !detail::replayChain(*last, nullptr, closedByCall, visit)) {
+    return;
+  }
+  if (!closedByCall) {
+    visit(*last, nullptr, last->pips[0] != last->pips[1] ? Action::Type::FOLD : Action::Type::CHECK);
+  }
+}
+
+} // namespace pokerbots::skeleton
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace pokerbots::skeleton {
+
+// Raw little-endian helpers for the skeleton's binary table formats.
+
+template <typename T> void writeValue(std::ostream &out, const T &value) {
+  out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T> void writeVector(std::ostream &out, const std::vector<T> &values) {
+  out.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+}
+
+template <typename T> bool readValue(std::istream &in, T &value) {
+  return static_cast<bool>(in.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+template <typename T> bool readVector(std::istream &in, std::vector<T> &values, std::uint64_t size) {
+  values.resize(size);
+  return static_cast<bool>(in.read(reinterpret_cast<char *>(values.data()), size * sizeof(T)));
+}
+
+} // namespace pokerbots::skeleton
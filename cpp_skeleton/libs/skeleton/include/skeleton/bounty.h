@@ -0,0 +1,68 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "card_set.h"
+
+namespace pokerbots::skeleton {
+
+inline constexpr int BOARD_CARDS = 5;
+
+/*
+  Probability that at least one of `live` cards of a rank is among `toCome`
+  cards dealt from `unseen`: 1 - C(unseen - live, toCome) / C(unseen, toCome),
+  for every count a hand can reach.
+*/
+class BountyOdds {
+public:
+  constexpr BountyOdds() {
+    for (int toCome = 0; toCome <= BOARD_CARDS; ++toCome) {
+      for (int unseen = 0; unseen <= NUM_CARDS; ++unseen) {
+        for (int live = 0; live <= NUM_SUITS; ++live) {
+          // misses one card at a time
+          double miss = 1;
+          for (int i = 0; i < toCome && i < unseen; ++i) {
+            miss *= static_cast<double>(std::max(0, unseen - live - i)) / (unseen - i);
+          }
+          odds[toCome][unseen][live] = toCome > 0 && unseen > 0 ? 1 - miss : 0;
+        }
+      }
+    }
+  }
+
+  constexpr double operator()(int toCome, int unseen, int live) const { return odds[toCome][unseen][live]; }
+
+private:
+  double odds[BOARD_CARDS + 1][NUM_CARDS + 1][NUM_SUITS + 1] = {};
+};
+
+inline constexpr BountyOdds BOUNTY_ODDS{};
+
+/*
+  Exact probability that our bounty rank is in our hole cards or on the final
+  board, 1 once it is. Cards in dead are known not to come, e.g. shown
+  elsewhere; the opponent's unknown hole cards are as likely as any to hold
+  the rank and need no special treatment.
+*/
+inline double bountyHitProbability(const std::array<int, 2> &hole, const std::vector<int> &board, int bountyRank,
+                                   CardSet dead = {}) {
+  if (bountyRank < 0) {
+    return 0;
+  }
+  auto known = CardSet::of(hole) | CardSet::of(board);
+  CardSet rank;
+  for (int suit = 0; suit < NUM_SUITS; ++suit) {
+    rank.add(cardIndex(bountyRank, suit));
+  }
+  if (known.intersects(rank)) {
+    return 1;
+  }
+  dead -= known;
+  int unseen = NUM_CARDS - known.size() - dead.size();
+  int live = NUM_SUITS - (dead & rank).size();
+  return BOUNTY_ODDS(BOARD_CARDS - static_cast<int>(board.size()), unseen, live);
+}
+
+} // namespace pokerbots::skeleton
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "concurrent_cache.h"
+#include "evaluator.h"
+#include "random.h"
+
+namespace pokerbots::skeleton {
+
+// Streets 0, 3, 4, 5 map to slots 0..3.
+inline int streetSlot(int street) { return street == 0 ? 0 : street - 2; }
+
+/*
+  Canonical form of a (hole cards, board) situation. Hole cards and the flop are
+  unordered, turn and river are not, and suits can be relabelled freely: the key
+  is the smallest packing over all 24 suit permutations.
+*/
+std::uint64_t canonicalSituation(const std::array<int, 2> &hole, const std::vector<int> &board);
+
+/*
+  Histogram over sampled runouts of our river equity against a random hand.
+  Each runout's equity is estimated from `opponents` sampled hands.
+*/
+std::vector<float> equityHistogram(const std::array<int, 2> &hole, const std::vector<int> &board,
+                                   int bins, int runouts, int opponents, Rng &rng);
+
+// Earth mover's distance between two normalized 1-D histograms, in bins.
+float earthMoversDistance(const float *a, const float *b, int bins);
+
+struct StreetBuckets {
+  int buckets = 0;
+  int bins = 0;
+  std::vector<float> centroids;    // buckets x bins
+  std::vector<std::uint64_t> keys; // sorted canonical situations
+  std::vector<std::uint16_t> assignment;
+
+  int nearest(const float *histogram) const;
+};
+
+// Situation -> bucket lookup tables written by tools/bucketer and loaded by the bot.
+class BucketTable {
+public:
+  BucketTable();
+
+  bool load(const std::string &path);
+
+  bool save(const std::string &path) const;
+
+  bool hasStreet(int street) const { return streets[streetSlot(street)].buckets > 0; }
+
+  int numBuckets(int street) const { return streets[streetSlot(street)].buckets; }
+
+  StreetBuckets &forStreet(int street) { return streets[streetSlot(street)]; }
+
+  /*
+    Bucket of a situation, -1 if there is no table for its street. Situations
+    that were not enumerated offline fall back to the nearest centroid of a
+    freshly sampled histogram, which is kept for the next thread asking about
+    the same canonical situation.
+  */
+  int bucket(const std::array<int, 2> &hole, const std::vector<int> &board,
+             Rng &rng) const;
+
+  ConcurrentCache<std::int32_t>::Stats fallbackStats() const { return fallback->stats(); }
+
+private:
+  std::array<StreetBuckets, 4> streets;
+  std::unique_ptr<ConcurrentCache<std::int32_t>> fallback;
+};
+
+} // namespace pokerbots::skeleton
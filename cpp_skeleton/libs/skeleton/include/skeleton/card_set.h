@@ -0,0 +1,160 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+
+#include "evaluator.h"
+#include "random.h"
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace pokerbots::skeleton {
+
+/*
+  A set of cards as a 52-bit mask, bit i standing for card index i. Union,
+  difference and membership are single instructions, size() is a popcount,
+  and iteration walks the set bits lowest first, so dead cards, blockers and
+  the undealt deck need no loops over the 52 cards.
+*/
+class CardSet {
+public:
+  constexpr CardSet() = default;
+  constexpr explicit CardSet(std::uint64_t bits) : mask(bits & FULL) {}
+
+  constexpr CardSet(std::initializer_list<int> cards) {
+    for (int card : cards) {
+      mask |= 1ULL << card;
+    }
+  }
+
+  template <typename Cards> static constexpr CardSet of(const Cards &cards) {
+    CardSet set;
+    for (int card : cards) {
+      set.mask |= 1ULL << card;
+    }
+    return set;
+  }
+
+  static constexpr CardSet of(const int *cards, int n) {
+    CardSet set;
+    for (int i = 0; i < n; ++i) {
+      set.mask |= 1ULL << cards[i];
+    }
+    return set;
+  }
+
+  static constexpr CardSet card(int card) { return CardSet(1ULL << card); }
+  static constexpr CardSet deck() { return CardSet(FULL); }
+
+  constexpr std::uint64_t bits() const { return mask; }
+  constexpr bool empty() const { return mask == 0; }
+  constexpr int size() const { return __builtin_popcountll(mask); }
+  constexpr bool contains(int card) const { return (mask >> card) & 1; }
+  constexpr bool intersects(CardSet other) const { return (mask & other.mask) != 0; }
+
+  constexpr void add(int card) { mask |= 1ULL << card; }
+  constexpr void remove(int card) { mask &= ~(1ULL << card); }
+
+  constexpr CardSet operator|(CardSet other) const { return CardSet(mask | other.mask); }
+  constexpr CardSet operator&(CardSet other) const { return CardSet(mask & other.mask); }
+  constexpr CardSet operator-(CardSet other) const { return CardSet(mask & ~other.mask); }
+  constexpr CardSet operator~() const { return CardSet(~mask); }
+  constexpr CardSet &operator|=(CardSet other) {
+    mask |= other.mask;
+    return *this;
+  }
+
+  constexpr CardSet &operator&=(CardSet other) {
+    mask &= other.mask;
+    return *this;
+  }
+
+  constexpr CardSet &operator-=(CardSet other) {
+    mask &= ~other.mask;
+    return *this;
+  }
+
+  constexpr bool operator==(CardSet other) const { return mask == other.mask; }
+  constexpr bool operator!=(CardSet other) const { return mask != other.mask; }
+
+  // Lowest card in the set; the set must not be empty.
+  constexpr int lowest() const { return __builtin_ctzll(mask); }
+
+  // The n-th lowest card, counting from 0; n must be below size().
+  int nth(int n) const {
+#if defined(__BMI2__)
+    return __builtin_ctzll(_pdep_u64(1ULL << n, mask));
+#else
+    // find the 16-bit lane holding it by popcount, then clear the lanes' lower cards
+    int base = 0;
+    auto rest = mask;
+    for (int lane = 0; lane < 3; ++lane) {
+      int count = __builtin_popcountll(rest & 0xFFFF);
+      if (n < count) {
+        break;
+      }
+      n -= count;
+      rest >>= 16;
+      base += 16;
+    }
+    for (; n > 0; --n) {
+      rest &= rest - 1;
+    }
+    return base + __builtin_ctzll(rest);
+#endif
+  }
+
+  // A card drawn uniformly from the set; the set must not be empty.
+  int sample(Rng &rng) const { return nth(static_cast<int>(rng.below(static_cast<std::uint32_t>(size())))); }
+
+  // Writes the cards in increasing order, returns how many there are.
+  int indices(int *out) const {
+    int n = 0;
+    for (auto rest = mask; rest; rest &= rest - 1) {
+      out[n++] = __builtin_ctzll(rest);
+    }
+    return n;
+  }
+
+  // Same, as Cactus-Kev codes.
+  int codes(CardCode *out) const {
+    int n = 0;
+    for (auto rest = mask; rest; rest &= rest - 1) {
+      out[n++] = CARD_CODES[__builtin_ctzll(rest)];
+    }
+    return n;
+  }
+
+  class iterator {
+  public:
+    constexpr explicit iterator(std::uint64_t rest) : rest(rest) {}
+    constexpr int operator*() const { return __builtin_ctzll(rest); }
+    constexpr iterator &operator++() {
+      rest &= rest - 1;
+      return *this;
+    }
+    constexpr bool operator!=(iterator other) const { return rest != other.rest; }
+
+  private:
+    std::uint64_t rest;
+  };
+
+  constexpr iterator begin() const { return iterator(mask); }
+  constexpr iterator end() const { return iterator(0); }
+
+private:
+  static constexpr std::uint64_t FULL = (1ULL << NUM_CARDS) - 1;
+
+  std::uint64_t mask = 0;
+};
+
+// Card index of a Cactus-Kev code: the rank is stored as is, the suit as one bit of four.
+inline constexpr int cardOfCode(CardCode code) {
+  constexpr std::array<int, 16> SUIT_OF_BIT = {-1, 3, 2, -1, 1, -1, -1, -1, 0};
+  return cardIndex(static_cast<int>((code >> 8) & 0xF), SUIT_OF_BIT[(code >> 12) & 0xF]);
+}
+
+} // namespace pokerbots::skeleton
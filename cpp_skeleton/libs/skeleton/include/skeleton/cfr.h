@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "buckets.h"
+#include "game_tree.h"
+#include "random.h"
+#include "strategy_table.h"
+#include "thread_pool.h"
+
+namespace pokerbots::skeleton {
+
+/*
+  Card abstraction used by the solver and by anything querying its output.
+  Streets with a bucket table use it, unless left out of `streets`; the rest
+  fall back to 169 preflop classes and to evenly sized slices of the
+  hand-value scale after the flop.
+*/
+class CardAbstraction {
+public:
+  // One bit per street slot, see streetSlot.
+  static constexpr std::uint8_t ALL_STREETS = 0xF;
+
+  explicit CardAbstraction(const BucketTable *table = nullptr, int fallbackBuckets = 50,
+                           std::uint8_t streets = ALL_STREETS);
+
+  int numBuckets(int street) const;
+
+  int fallback() const { return fallbackBuckets; }
+
+  // The streets whose buckets come from the table, one bit per street slot.
+  std::uint8_t bucketedStreets() const;
+
+  int bucket(const std::array<int, 2> &hole, const std::vector<int> &board, Rng &rng) const;
+
+private:
+  bool usesTable(int street) const;
+
+  const BucketTable *table;
+  int fallbackBuckets;
+  std::uint8_t streets;
+  std::vector<std::uint64_t> preflopClasses;
+};
+
+/*
+  External-sampling Monte Carlo CFR over the abstract game, with the engine's
+  bounty payoffs: the winner of a pot whose bounty rank is in their hole cards or
+  on the board dealt so far wins BOUNTY_RATIO times the loser's contribution plus
+  BOUNTY_CONSTANT, and a bounty on a split pot is worth (ratio - 1) / 2 of it plus
+  the constant.
+
+  Worker threads traverse independently and share the regret and strategy
+  arrays through relaxed atomic adds.
+*/
+class Solver {
+public:
+  Solver(const GameTree &tree, const CardAbstraction &cards);
+
+  /*
+    Runs `iterations` more iterations, each one traversal per player.
+    Writes a checkpoint every `checkpointInterval` iterations if a path is given.
+  */
+  void run(std::uint64_t iterations, ThreadPool &pool, unsigned seed,
+           std::uint64_t checkpointInterval = 0, const std::string &checkpointPath = "");
+
+  std::uint64_t iterations() const { return completed; }
+
+  bool saveCheckpoint(const std::string &path) const;
+
+  bool loadCheckpoint(const std::string &path);
+
+  // Average strategy for every info set, quantized into a StrategyTable file.
+  bool exportStrategy(const std::string &path) const;
+
+private:
+  struct Deal {
+    std::array<std::array<int, 2>, 2> hole;
+    std::array<int, 5> board;
+    std::array<std::array<int, 4>, 2> buckets;
+    std::array<std::array<bool, 4>, 2> bountyHit;
+    int winner; // 0, 1, or 2 for a split pot
+  };
+
+  Deal deal(Rng &rng) const;
+
+  double payoff(const GameNode &node, const Deal &deal, int player) const;
+
+  double traverse(int node, int traverser, const Deal &deal, Rng &rng);
+
+  const GameTree &tree;
+  const CardAbstraction &cards;
+  InfoSetLayout layout;
+  std::unique_ptr<std::atomic<float>[]> regrets;
+  std::unique_ptr<std::atomic<float>[]> strategySums;
+  std::uint64_t completed = 0;
+};
+
+} // namespace pokerbots::skeleton
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+namespace pokerbots::skeleton {
+
+/*
+  Bounded map from 64-bit keys (any but EMPTY) to small trivially copyable
+  values, shared by any number of threads.
+
+  The table is set-associative: a key hashes to one set of WAYS slots, and a
+  full set evicts by CLOCK, the hand sweeping the set and clearing reference
+  bits until it finds a slot nobody has read since the last sweep. Reads take
+  no lock. Each slot carries a sequence number that writers make odd for the
+  duration of a write, and a reader that sees it change retries. Writers
+  serialize on one of a fixed number of stripe locks.
+*/
+template <typename Value> class ConcurrentCache {
+  static_assert(std::is_trivially_copyable_v<Value>, "values are copied word by word");
+
+public:
+  static constexpr int WAYS = 8;
+  static constexpr int STRIPES = 64;
+  static constexpr std::uint64_t EMPTY = ~0ULL;
+
+  struct Stats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t evictions = 0;
+
+    double hitRate() const { return hits + misses > 0 ? static_cast<double>(hits) / (hits + misses) : 0; }
+  };
+
+  // Room for at least `capacity` values, rounded up to a power of two sets.
+  explicit ConcurrentCache(std::size_t capacity) {
+    std::size_t sets = 1;
+    while (sets * WAYS < capacity) {
+      sets <<= 1;
+    }
+    setMask = sets - 1;
+    slots = std::make_unique<Slot[]>(sets * WAYS);
+    hands = std::make_unique<std::uint8_t[]>(sets);
+  }
+
+  std::size_t capacity() const { return (setMask + 1) * WAYS; }
+
+  // Copies the value stored for key into value; lock-free.
+  bool find(std::uint64_t key, Value &value) const {
+    auto set = setOf(key);
+    auto &counters = stripes[set % STRIPES];
+    for (int way = 0; way < WAYS; ++way) {
+      auto &slot = slots[set * WAYS + way];
+      while (true) {
+        auto before = slot.sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+          continue; // a writer is halfway through this slot
+        }
+        if (slot.key.load(std::memory_order_relaxed) != key) {
+          break;
+        }
+        std::array<std::uint64_t, WORDS> copy;
+        for (int w = 0; w < WORDS; ++w) {
+          copy[w] = slot.words[w].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != before) {
+          continue;
+        }
+        std::memcpy(static_cast<void *>(&value), copy.data(), sizeof(Value)); // trivially copyable, asserted above
+        slot.referenced.store(true, std::memory_order_relaxed);
+        counters.hits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    counters.misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  // Stores value for key, replacing what was stored for it or evicting from its set.
+  void insert(std::uint64_t key, const Value &value) {
+    auto set = setOf(key);
+    auto &stripe = stripes[set % STRIPES];
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    auto *ways = &slots[set * WAYS];
+    int chosen = -1;
+    for (int way = 0; way < WAYS && chosen < 0; ++way) {
+      if (ways[way].key.load(std::memory_order_relaxed) == key) {
+        chosen = way;
+      }
+    }
+    while (chosen < 0) {
+      auto &candidate = ways[hands[set]];
+      if (candidate.key.load(std::memory_order_relaxed) == EMPTY) {
+        chosen = hands[set];
+      } else if (!candidate.referenced.exchange(false, std::memory_order_relaxed)) {
+        chosen = hands[set];
+        stripe.evictions.fetch_add(1, std::memory_order_relaxed);
+      }
+      hands[set] = static_cast<std::uint8_t>((hands[set] + 1) % WAYS);
+    }
+
+    std::array<std::uint64_t, WORDS> copy{};
+    std::memcpy(copy.data(), &value, sizeof(Value));
+    auto &slot = ways[chosen];
+    auto sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.key.store(key, std::memory_order_relaxed);
+    for (int w = 0; w < WORDS; ++w) {
+      slot.words[w].store(copy[w], std::memory_order_relaxed);
+    }
+    slot.referenced.store(true, std::memory_order_relaxed);
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+  }
+
+  Stats stats() const {
+    Stats total;
+    for (const auto &stripe : stripes) {
+      total.hits += stripe.hits.load(std::memory_order_relaxed);
+      total.misses += stripe.misses.load(std::memory_order_relaxed);
+      total.evictions += stripe.evictions.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+private:
+  static constexpr int WORDS = static_cast<int>((sizeof(Value) + 7) / 8);
+
+  struct Slot {
+    std::atomic<std::uint64_t> sequence{0}; // odd while a write is in progress
+    std::atomic<std::uint64_t> key{EMPTY};
+    std::atomic<bool> referenced{false};
+    std::array<std::atomic<std::uint64_t>, WORDS> words{};
+  };
+
+  // the writer lock and the counters of the sets whose index is congruent to it
+  struct alignas(64) Stripe {
+    std::mutex mutex;
+    mutable std::atomic<std::uint64_t> hits{0};
+    mutable std::atomic<std::uint64_t> misses{0};
+    std::atomic<std::uint64_t> evictions{0};
+  };
+
+  std::size_t setOf(std::uint64_t key) const {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return static_cast<std::size_t>(key) & setMask;
+  }
+
+  std::size_t setMask = 0;
+  std::unique_ptr<Slot[]> slots;
+  std::unique_ptr<std::uint8_t[]> hands; // CLOCK hand per set, guarded by the set's stripe
+  std::array<Stripe, STRIPES> stripes;
+};
+
+} // namespace pokerbots::skeleton
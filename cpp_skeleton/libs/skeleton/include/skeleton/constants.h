@@ -10,5 +10,7 @@ inline constexpr int NUM_ROUNDS = 1000;
 inline constexpr int STARTING_STACK = 400;
 inline constexpr int BIG_BLIND = 2;
 inline constexpr int SMALL_BLIND = 1;
+inline constexpr double BOUNTY_RATIO = 1.5;
+inline constexpr int BOUNTY_CONSTANT = 10;
 
 } // namespace pokerbots::skeleton
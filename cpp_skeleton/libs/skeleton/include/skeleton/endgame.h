@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+
+#include "constants.h"
+
+namespace pokerbots::skeleton {
+
+/*
+  Exact chance of winning the match by folding every remaining round.
+
+  Folding costs the blind we posted, 1 as the dealer and 2 as the big blind
+  facing a raise, and the opponent's bounty multiplies either up to 12 or 13
+  when their hole cards hold its rank. That happens independently every
+  round with the same probability, whatever the rank and wherever we are in
+  its period. So the total cost is the blinds plus 11 per hit, and the chance
+  of finishing ahead is a binomial tail, tabulated for every number of rounds
+  by P(r, k) = p P(r - 1, k - 1) + (1 - p) P(r - 1, k).
+
+  The opponent is assumed to raise every big blind we post, which makes the
+  probabilities lower bounds. Seen from the other seat they are the
+  opponent's chances of locking the match in against us.
+
+  Folding is the only policy modelled. What checking or calling down costs
+  depends on how the opponent bets, so it has no opponent-free table like
+  this one.
+*/
+class FoldOutOdds {
+public:
+  explicit FoldOutOdds(int rounds = NUM_ROUNDS);
+
+  // P(final bankroll > 0) folding `remaining` rounds, this one included, starting from bankroll.
+  double winProbability(int remaining, int bankroll, bool bigBlind) const;
+
+  // The smallest bankroll that wins with at least `confidence` by folding out.
+  int lockInBankroll(int remaining, bool bigBlind, double confidence) const;
+
+  // What folding out costs if every one of the opponent's bounties hits.
+  int worstCase(int remaining, bool bigBlind) const { return blinds(remaining, bigBlind) + HIT_COST * remaining; }
+
+  // Extra cost of a fold when the opponent's bounty hits, the same in either blind.
+  static constexpr int HIT_COST = 11;
+
+private:
+  static int blinds(int remaining, bool bigBlind);
+
+  double hitOdds;
+  std::vector<std::vector<double>> atMost; // [rounds][hits]: P(at most `hits` bounties hit in `rounds`)
+};
+
+} // namespace pokerbots::skeleton
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "card_set.h"
+#include "evaluator.h"
+
+namespace pokerbots::skeleton {
+
+inline constexpr int NUM_COMBOS = 1326;
+
+struct HoleCards {
+  int first;
+  int second;
+};
+
+// Hole-card combos are indexed in lexicographic (low card, high card) order.
+inline constexpr std::array<HoleCards, NUM_COMBOS> makeComboCards() {
+  std::array<HoleCards, NUM_COMBOS> cards{};
+  int combo = 0;
+  for (int i = 0; i < NUM_CARDS; ++i) {
+    for (int j = i + 1; j < NUM_CARDS; ++j) {
+      cards[combo++] = {i, j};
+    }
+  }
+  return cards;
+}
+
+inline constexpr std::array<HoleCards, NUM_COMBOS> COMBO_CARDS = makeComboCards();
+
+inline constexpr CardSet comboSet(int combo) { return CardSet{COMBO_CARDS[combo].first, COMBO_CARDS[combo].second}; }
+
+inline constexpr int comboIndex(int c1, int c2) {
+  if (c1 > c2) {
+    auto low = c2;
+    c2 = c1;
+    c1 = low;
+  }
+  // combos starting with a card below c1, then the offset of c2 within c1's row
+  return c1 * (2 * NUM_CARDS - c1 - 1) / 2 + (c2 - c1 - 1);
+}
+
+// Weight per combo; combos that are not in the range carry zero.
+using Range = std::array<float, NUM_COMBOS>;
+
+struct RangeEquity {
+  std::vector<int> combosA; // live combos of range A, i.e. positive weight and not on the board
+  std::vector<int> combosB;
+  // combosA.size() x combosB.size(), row-major: share of runouts that combosA[i]
+  // wins / ties against combosB[j]. Pairs that share a card stay at zero.
+  std::vector<float> wins;
+  std::vector<float> ties;
+  Range equityA{}; // win + tie / 2 against range B, weighted by B; zero for dead combos
+  Range equityB{};
+};
+
+/*
+  Computes range-vs-range equity on a fixed board by enumerating every runout.
+
+  Each live combo is evaluated once per runout and both ranges are sorted by
+  hand value, so the per-combo equities cost a linear sweep per runout instead
+  of a comparison per pair. The pairwise matrix is inherently quadratic and is
+  only filled when withMatrix is set.
+
+  @param board Card indices of the 3 to 5 known board cards.
+*/
+RangeEquity computeRangeEquity(const std::vector<int> &board, const Range &rangeA,
+                               const Range &rangeB, bool withMatrix = true);
+
+} // namespace pokerbots::skeleton
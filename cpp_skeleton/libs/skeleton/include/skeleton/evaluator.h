@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace pokerbots::skeleton {
+
+// Cactus-Kev card code: prime in bits [7..0], rank in [11..8], suit in [15..12]
+// and a one-hot rank mask in [28..16].
+using CardCode = std::uint32_t;
+
+inline constexpr int NUM_CARDS = 52;
+inline constexpr int NUM_RANKS = 13;
+inline constexpr int NUM_SUITS = 4;
+
+inline constexpr int cardIndex(int rank, int suit) { return 13 * suit + rank; }
+inline constexpr int rankOf(int card) { return card % 13; }
+inline constexpr int suitOf(int card) { return card / 13; }
+
+inline constexpr CardCode makeCardCode(int rank, int suit) {
+  constexpr int primes[NUM_RANKS] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41};
+  return static_cast<CardCode>(primes[rank]) | (static_cast<CardCode>(rank) << 8) |
+         (0x8000u >> suit) | (1u << (16 + rank));
+}
+
+inline constexpr std::array<CardCode, NUM_CARDS> makeCardCodes() {
+  std::array<CardCode, NUM_CARDS> codes{};
+  for (int card = 0; card < NUM_CARDS; ++card) {
+    codes[card] = makeCardCode(rankOf(card), suitOf(card));
+  }
+  return codes;
+}
+
+// Cards are indexed 13 * suit + rank, with suits ordered c, d, h, s and ranks
+// ordered 2..A. This matches the order Deck::init lays the codes out in.
+inline constexpr std::array<CardCode, NUM_CARDS> CARD_CODES = makeCardCodes();
+
+// Parses "Ah" style strings, returns -1 if the string is not a card.
+int cardIndex(const std::string &card);
+
+// Rank index 0..12 for '2'..'A', -1 otherwise.
+int rankIndex(char rank);
+
+std::string cardString(int card);
+
+// Hand values follow Cactus-Kev: 1 is a royal flush, 7462 is 7-5-4-3-2 offsuit.
+// Lower is better.
+unsigned short eval5(CardCode c1, CardCode c2, CardCode c3, CardCode c4, CardCode c5);
+
+// Best five-card value out of 5, 6 or 7 card codes.
+unsigned short eval7(const CardCode *cards, int n);
+
+// Same, for card indices.
+unsigned short evalIndices(const int *cards, int n);
+
+} // namespace pokerbots::skeleton
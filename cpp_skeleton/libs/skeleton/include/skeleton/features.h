@@ -0,0 +1,201 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "card_set.h"
+#include "concurrent_cache.h"
+#include "evaluator.h"
+#include "random.h"
+
+namespace pokerbots::skeleton {
+
+// Hand strength and potential against a uniformly random opponent hand.
+struct HandFeatures {
+  double equity = 0;       // P(win) + P(tie) / 2 at showdown
+  double notBehind = 0;    // P(win) + P(tie) at showdown, the convention the bot's thresholds were tuned on
+  double handStrength = 0; // the same on the current board, before any more cards
+  double ehs = 0;          // HS * (1 - NPot) + (1 - HS) * PPot
+  double ehs2 = 0;         // E[HS^2] over runouts, rewards draws over marginal made hands
+  double ppot = 0;         // P(ahead at showdown | behind or tied now)
+  double npot = 0;         // P(behind at showdown | ahead or tied now)
+  double bountyHit = 0;    // P(our bounty rank shows up in our hole cards or the final board)
+  double equityIfHit = 0;  // equity over the runouts where it does, 0 if none did
+  double equityIfMiss = 0; // and where it does not
+};
+
+// Raw sums behind HandFeatures. Counts from separate passes over the same
+// situation can be merged before finishing.
+struct FeatureCounts {
+  enum Standing { AHEAD, TIED, BEHIND };
+
+  // [standing now][standing at showdown], counted in (runout, opponent) samples
+  std::array<std::array<double, 3>, 3> transitions{};
+  double runouts = 0;
+  double squaredStrengthSum = 0; // per-runout unbiased estimates of HS^2
+  double squaredRunouts = 0;     // runouts that contributed to squaredStrengthSum
+  double bountyHits = 0;
+  double hitSamples = 0;  // (runout, opponent) samples whose runout hits our bounty
+  double hitStrength = 0; // their wins + ties / 2
+
+  void merge(const FeatureCounts &other);
+
+  HandFeatures finish() const;
+};
+
+// How sampleFeatures draws runouts and opponent hands. Every strategy leaves each feature unbiased.
+enum class Sampling {
+  RANDOM,       // independent uniform draws
+  STRATIFIED,   // every live card leads the same share of runouts, from a random starting card
+  QUASI_RANDOM, // runout cards from a randomly shifted two-dimensional Sobol sequence
+  ANTITHETIC,   // opponent hands in pairs mirrored by rank, so a weak hand comes with a strong one
+};
+
+/*
+  Samples runouts and opponent hands once and derives every feature from the
+  same evaluations: our hand is scored once per runout and each opponent hand
+  once on the current board and once at showdown.
+
+  @param hole Our two hole cards as card indices.
+  @param board The 3 to 5 known board cards.
+  @param bountyRank Our bounty rank index, or -1 if unknown.
+  @param runouts Number of runouts to sample. On the river there is a single runout.
+  @param opponentsPerRunout Opponent hands sampled per runout; at least two so
+         that HS^2 can be estimated without bias, and at least four and even
+         for ANTITHETIC, whose pairs count as one draw each for HS^2.
+  @param sampling How runouts and opponent hands are drawn.
+*/
+FeatureCounts sampleFeatures(const std::array<int, 2> &hole, const std::vector<int> &board,
+                             int bountyRank, int runouts, int opponentsPerRunout,
+                             Rng &rng, Sampling sampling = Sampling::RANDOM);
+
+/*
+  Feature counts per situation (hole cards, board, bounty rank), kept for one
+  round. Each decision in a situation adds a batch of samples to what is
+  stored, so facing a re-raise on the same street refines the earlier
+  estimate instead of drawing an unrelated one. Every situation samples from
+  its own stream seeded by the situation, so the counts a decision sees do
+  not depend on whether its first batch was sampled ahead of time.
+
+  With a shared cache, a situation seen in an earlier round, suits
+  relabelled or not, starts from the counts stored for it there instead of
+  sampling its first batch, and every refinement is written back.
+*/
+class FeatureMemo {
+public:
+  FeatureMemo(std::uint64_t seed, int runoutsPerBatch, int opponentsPerRunout, int maxBatches,
+              ConcurrentCache<FeatureCounts> *shared = nullptr, Sampling sampling = Sampling::RANDOM);
+
+  // Counts with one batch more than the previous decision in this situation saw, up to maxBatches.
+  const FeatureCounts &refine(const std::array<int, 2> &hole, const std::vector<int> &board, int bountyRank);
+
+  // Samples the first batch of a situation ahead of its decision; returns false if it already has one.
+  bool prepare(const std::array<int, 2> &hole, const std::vector<int> &board, int bountyRank);
+
+  // Forgets every situation, at the start of a round.
+  void clear() { entries.clear(); }
+
+  // Runouts sampled per batch from now on, e.g. fewer once the clock runs low.
+  void setRunoutsPerBatch(int runouts) { runoutsPerBatch = runouts; }
+
+private:
+  struct Key {
+    std::uint64_t hole;
+    std::uint64_t board;
+    int bountyRank;
+
+    bool operator==(const Key &other) const {
+      return hole == other.hole && board == other.board && bountyRank == other.bountyRank;
+    }
+  };
+
+  struct KeyHash {
+    std::size_t operator()(const Key &key) const {
+      return (key.hole ^ key.board * 0x9e3779b97f4a7c15ULL) + static_cast<std::size_t>(key.bountyRank);
+    }
+  };
+
+  struct Entry {
+    FeatureCounts counts;
+    Rng rng;
+    std::uint64_t sharedKey = 0;
+    int batches = 0;
+    int decisions = 0;
+  };
+
+  Entry &entry(const std::array<int, 2> &hole, const std::vector<int> &board, int bountyRank);
+  void sample(Entry &entry, const std::array<int, 2> &hole, const std::vector<int> &board, int bountyRank,
+              int batches);
+
+  std::uint64_t seed;
+  int runoutsPerBatch;
+  int opponentsPerRunout;
+  int maxBatches;
+  ConcurrentCache<FeatureCounts> *shared;
+  Sampling sampling;
+  std::unordered_map<Key, Entry, KeyHash> entries;
+};
+
+// Process-wide feature counts by canonical situation and bounty rank, for FeatureMemo.
+ConcurrentCache<FeatureCounts> &sharedFeatureCache();
+
+// One way to go on with the hand, in chips put into the pot this round.
+struct Candidate {
+  double ours;       // what we have put in so far
+  double theirs;     // what the opponent has put in so far
+  double to;         // our total after the action; a call or check matches theirs
+  double continuing; // share of the opponent's hands, strongest first, that call a raise
+};
+
+struct Estimate {
+  double mean = 0;
+  double standardError = 0;
+};
+
+/*
+  Runouts and opponent hands drawn once per decision, so that every candidate
+  action is valued on the same draws (common random numbers). The noise of
+  the draws is mostly shared between candidates and cancels in difference(),
+  which therefore ranks two candidates with far fewer samples than comparing
+  independent estimates would.
+
+  A candidate is worth the round's bankroll change for us, bounty included,
+  if the hand is checked down after it. A raise is called by the opponent
+  hands that are strongest on the current board, up to `continuing` of them,
+  and the rest fold. The opponent's bounty is unknown and left out.
+*/
+class ActionSamples {
+public:
+  ActionSamples() = default;
+
+  ActionSamples(const std::array<int, 2> &hole, const std::vector<int> &board, int bountyRank, int runouts,
+                int opponentsPerRunout, Rng &rng);
+
+  bool empty() const { return samples.empty(); }
+
+  Estimate value(const Candidate &candidate) const;
+
+  // value(a) - value(b) and the standard error of the paired difference.
+  Estimate difference(const Candidate &a, const Candidate &b) const;
+
+  // Minimum defence frequency: the share of hands that keeps a bet into pot from profiting with any two cards.
+  static double defendingShare(double pot, double bet) { return pot / (pot + bet); }
+
+private:
+  struct Sample {
+    unsigned short theirsNow; // opponent's hand value on the current board, lower is better
+    float showdown;           // 1, 0.5 or 0 for us at showdown
+    bool bountyHit;           // our bounty rank is in our hand or on the final board
+  };
+
+  double payoff(const Sample &sample, const Candidate &candidate, unsigned short callingValue) const;
+  unsigned short callingValue(double continuing) const;
+
+  std::vector<Sample> samples;
+  std::vector<unsigned short> sortedTheirsNow;
+  bool bountyNow = false; // what a fold by the opponent pays
+};
+
+} // namespace pokerbots::skeleton
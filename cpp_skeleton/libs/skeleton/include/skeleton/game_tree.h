@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "actions.h"
+#include "states.h"
+
+namespace pokerbots::skeleton {
+
+// Which bets the abstract game allows at every decision.
+struct BetAbstraction {
+  std::vector<double> potFractions = {0.5, 1.0}; // raise by this share of the pot after calling
+  bool allIn = true;
+  int maxRaisesPerStreet = 3;
+};
+
+struct GameNode {
+  enum Kind : std::uint8_t { DECISION, FOLD, SHOWDOWN, LEAF }; // LEAF: cut off by a depth limit
+
+  Kind kind = DECISION;
+  std::uint8_t player = 0; // player to act, or the player who folded
+  std::uint8_t street = 0; // 5 at a showdown, the next street at a leaf
+  std::uint8_t numActions = 0;
+  std::uint32_t firstChild = 0; // children are numActions consecutive nodes
+  std::uint32_t parent = 0;
+  Action action; // taken at the parent to get here
+  std::array<int, 2> contributions = {0, 0};
+  std::array<int, 2> pips = {0, 0};
+};
+
+/*
+  Abstract betting tree for one heads-up round. Every transition goes through
+  RoundState::proceed and every raise is clamped to RoundState::raiseBounds, so
+  the tree follows the engine's rules exactly; only the raise sizes are
+  abstracted. Players are indexed as in RoundState: 0 is the small blind.
+
+  Nodes live in one flat array. The children of a node are consecutive and the
+  subtrees below them follow in depth-first order, so a node index is a complete
+  encoding of the betting history that led to it and the path to it is a string
+  of small action indices.
+*/
+class GameTree {
+public:
+  explicit GameTree(BetAbstraction abstraction = {});
+
+  // Subtree from `start`, with the betting after `lastStreet` cut off into LEAF nodes.
+  GameTree(const RoundStatePtr &start, BetAbstraction abstraction, int lastStreet = 5, int raisesThisStreet = 0);
+
+  const BetAbstraction &abstraction() const { return bets; }
+
+  const GameNode &node(int index) const { return nodes[index]; }
+
+  int size() const { return static_cast<int>(nodes.size()); }
+
+  static constexpr int root() { return 0; }
+
+  int child(int index, int action) const { return static_cast<int>(nodes[index].firstChild) + action; }
+
+  const Action &action(int index, int action) const { return nodes[child(index, action)].action; }
+
+  // Action indices from the root down to `index`.
+  std::vector<std::uint8_t> history(int index) const;
+
+  // Node reached from the root by a string of action indices, or -1.
+  int follow(const std::vector<std::uint8_t> &history) const;
+
+  // Child reached by an actual action, mapping off-tree raises to the closest abstract size.
+  int translate(int index, const Action &action) const;
+
+  // Decision node matching the betting so far in `state`, or -1 if it left the tree; replays the whole round.
+  int locate(const RoundState &state) const;
+
+private:
+  void describe(int index, const RoundState &state);
+
+  void expand(int index, const RoundStatePtr &state, int raisesThisStreet);
+
+  BetAbstraction bets;
+  int lastStreet = 5;
+  std::vector<GameNode> nodes;
+};
+
+/*
+  Follows one round through a tree as it is played. Each sync translates only
+  the actions since the state of the previous sync, ours and the opponent's,
+  and falls back to replaying the round from the root when that state is not
+  on the new one's chain.
+*/
+class TreeCursor {
+public:
+  explicit TreeCursor(const GameTree &tree) : tree(&tree) {}
+
+  // Starts over at the root for a new round.
+  void reset();
+
+  // Decision node of `state`, or -1 once the round has left the tree.
+  int sync(const RoundStatePtr &state);
+
+private:
+  friend class GameTree;
+
+  // Translates one action taken at `before`; false once the betting has left the tree.
+  bool step(const RoundState &before, const RoundState *after, Action::Type type);
+
+  const GameTree *tree;
+  int index = GameTree::root();
+  bool closedByCall = false;
+  RoundStatePtr last;
+};
+
+} // namespace pokerbots::skeleton
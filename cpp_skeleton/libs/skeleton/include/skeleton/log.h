@@ -0,0 +1,169 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+namespace pokerbots::skeleton {
+
+enum class LogLevel { DEBUG, INFO, WARN, ERROR };
+
+// Lines below this level are compiled out; set with -DPOKERBOT_LOG_LEVEL=<0..4>, 4 disabling logging.
+#ifndef POKERBOT_LOG_LEVEL
+#define POKERBOT_LOG_LEVEL 0
+#endif
+
+inline constexpr bool logCompiled(LogLevel level) { return static_cast<int>(level) >= POKERBOT_LOG_LEVEL; }
+
+// The engine keeps 512 KiB of each player's output, build output included.
+inline constexpr std::size_t DEFAULT_LOG_BUDGET = 480 * 1024;
+
+/*
+  Asynchronous line sink. Producers copy a formatted line into a slot of a
+  preallocated bounded queue (Vyukov's MPMC ring, lock-free for any number of
+  producers) and return; a background thread drains the queue in batches and
+  writes them with one system call each.
+
+  Once the byte budget is spent, later lines are dropped before they are
+  formatted, so logging costs almost nothing for the rest of the match. When
+  the queue is full the line is dropped rather than blocking a decision.
+*/
+class Logger {
+public:
+  static constexpr std::size_t LINE_CAPACITY = 248;
+  static constexpr std::size_t NUM_SLOTS = 2048;
+
+  explicit Logger(int fd = 1, std::size_t budget = DEFAULT_LOG_BUDGET);
+
+  // Writes out what is queued and stops the flush thread.
+  ~Logger();
+
+  Logger(const Logger &) = delete;
+  Logger &operator=(const Logger &) = delete;
+
+  // False once the budget is spent; callers skip formatting.
+  bool accepting() const { return used.load(std::memory_order_relaxed) < budget.load(std::memory_order_relaxed); }
+
+  // Queues one line, a newline is added.
+  void submit(const char *text, std::size_t length);
+
+  // Bytes that may still be written from now on; 0 silences the logger.
+  void setBudget(std::size_t bytes);
+
+  // Blocks until every line queued before the call has been written.
+  void flush();
+
+  std::uint64_t dropped() const { return droppedLines.load(std::memory_order_relaxed); }
+
+private:
+  struct Slot {
+    std::atomic<std::size_t> sequence;
+    std::uint32_t length;
+    char text[LINE_CAPACITY];
+  };
+
+  void drain();
+  bool writeBatch();
+
+  int fd;
+  std::array<Slot, NUM_SLOTS> slots;
+  alignas(64) std::atomic<std::size_t> enqueuePosition{0};
+  alignas(64) std::size_t dequeuePosition = 0;
+  std::atomic<std::size_t> used{0};
+  std::atomic<std::size_t> budget;
+  std::atomic<std::uint64_t> droppedLines{0};
+  std::atomic<std::uint64_t> written{0}; // lines taken off the queue
+  std::atomic<bool> stopping{false};
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable drained;
+  std::string batch;
+  std::thread flusher;
+};
+
+// The process-wide logger, writing to standard output.
+Logger &logger();
+
+/*
+  One line being formatted on the stack, queued when it goes out of scope.
+  Numbers are formatted with to_chars as std::cout would print them by
+  default; lines longer than the slot are cut.
+*/
+class LogLine {
+public:
+  LogLine() : live(logger().accepting()) {}
+
+  ~LogLine() {
+    if (live) {
+      logger().submit(text, length);
+    }
+  }
+
+  LogLine(const LogLine &) = delete;
+  LogLine &operator=(const LogLine &) = delete;
+
+  LogLine &operator<<(std::string_view s) {
+    if (live) {
+      append(s.data(), s.size());
+    }
+    return *this;
+  }
+
+  LogLine &operator<<(const char *s) { return *this << std::string_view(s); }
+
+  LogLine &operator<<(const std::string &s) { return *this << std::string_view(s); }
+
+  LogLine &operator<<(char c) { return *this << std::string_view(&c, 1); }
+
+  template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>> LogLine &operator<<(T value) {
+    if (!live) {
+      return *this;
+    }
+    char digits[32];
+    std::to_chars_result result;
+    if constexpr (std::is_same_v<T, bool>) {
+      result = std::to_chars(digits, digits + sizeof(digits), static_cast<int>(value));
+    } else if constexpr (std::is_floating_point_v<T>) {
+      result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::general, 6);
+    } else {
+      result = std::to_chars(digits, digits + sizeof(digits), value);
+    }
+    append(digits, result.ptr - digits);
+    return *this;
+  }
+
+private:
+  void append(const char *s, std::size_t n) {
+    n = std::min(n, Logger::LINE_CAPACITY - length);
+    std::memcpy(text + length, s, n);
+    length += n;
+  }
+
+  bool live;
+  std::size_t length = 0;
+  char text[Logger::LINE_CAPACITY];
+};
+
+} // namespace pokerbots::skeleton
+
+/*
+  POKERBOT_LOG(INFO) << "Loaded " << path;
+  Compiles to nothing for levels below POKERBOT_LOG_LEVEL. At compiled levels
+  every << operand is evaluated, even once the budget is spent, so operands
+  must not have side effects such as drawing random numbers: the bot would
+  then play differently depending on the log level.
+*/
+#define POKERBOT_LOG(level)                                                                                          \
+  if constexpr (!::pokerbots::skeleton::logCompiled(::pokerbots::skeleton::LogLevel::level)) {                       \
+  } else                                                                                                               \
+    ::pokerbots::skeleton::LogLine()
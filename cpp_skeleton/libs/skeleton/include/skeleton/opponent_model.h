@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "equity.h"
+#include "showdown_history.h"
+#include "states.h"
+
+namespace pokerbots::skeleton {
+
+// Exponentially decayed count of how often an event happened when it could.
+struct DecayedRate {
+  double hits = 0;
+  double trials = 0;
+
+  void observe(bool happened, double decay) {
+    hits = hits * decay + happened;
+    trials = trials * decay + 1;
+  }
+
+  // Posterior mean under a Beta prior with the given mean and weight.
+  double mean(double priorMean, double priorWeight) const {
+    return (hits + priorMean * priorWeight) / (trials + priorWeight);
+  }
+};
+
+// Decayed least-squares line of hand equity against bet size.
+struct StrengthFit {
+  double weight = 0;
+  double x = 0;
+  double y = 0;
+  double xx = 0;
+  double xy = 0;
+  double yy = 0;
+
+  void add(double size, double equity, double decay);
+};
+
+// Equity the opponent's hand is expected to have after a bet of some size.
+struct StrengthPrediction {
+  double mean;
+  double deviation;
+};
+
+/*
+  What the opponent tends to do, kept as decayed frequencies per street and
+  position so that the model follows an opponent who changes gears.
+
+  Every event has a Beta prior that stands in for the hands not seen yet, so
+  estimates are usable from the first hand and move smoothly as evidence comes
+  in. Per street and position cells are shrunk towards the event's overall
+  frequency rather than towards the prior, since they see far fewer hands.
+*/
+class OpponentModel {
+public:
+  enum Event {
+    BET,            // bets when checked to or first to act after the flop
+    POT_BET,        // a bet or raise after the flop is pot sized or more
+    RERAISE,        // raises our bet after the flop
+    OPEN_RAISE,     // raises rather than calls or folds as the dealer's first action
+    BIG_OPEN_RAISE, // an open raise puts in more than 12 and at most 20
+    THREE_BET,      // raises our preflop raise
+    PASSIVE_ROUND,  // ends the round having put in no more than the blind
+    NUM_EVENTS
+  };
+
+  OpponentModel();
+
+  // O(1); position is the opponent's seat, 0 for the dealer and 1 for the big blind.
+  void observe(Event event, int street, int position, bool happened);
+
+  // Replays the opponent's actions in a finished round and observes every event they allow.
+  void observeRound(const TerminalState &terminal, int opponent);
+
+  // Fits bet size against the equity the opponent turned out to hold, per street.
+  void observeShowdown(const ShowdownRecord &record);
+
+  double frequency(Event event) const;
+
+  double frequency(Event event, int street, int position) const;
+
+  // Decayed number of chances the opponent had for this event.
+  double observations(Event event) const { return overall[event].trials; }
+
+  // How many chances in a row, the latest included, the event happened at; this match only.
+  int run(Event event) const { return runs[event]; }
+
+  /*
+    Equity of the opponent's hand after they checked (potFraction 0) or raised
+    with the given price on `street`, or nothing until enough showdowns were seen.
+  */
+  std::optional<StrengthPrediction> predictStrength(int street, double potFraction) const;
+
+  /*
+    Scales range weights by how well each combo's equity against a random hand
+    fits predictStrength. On the river that equity is a plain hand ranking, on
+    the turn the ranking averaged over every river card; other streets are left
+    alone. Returns whether the range was changed.
+  */
+  bool narrowRange(Range &range, const std::vector<int> &board, double potFraction) const;
+
+  /*
+    Profiles carry the counters and fits between matches against the same bot.
+    Saving writes next to the target and renames, so a profile is never left
+    half written. Loading scales the stored evidence by carryOver, so an
+    opponent who changed since is re-learned quickly.
+  */
+  bool save(const std::string &path) const;
+
+  bool load(const std::string &path, double carryOver = 1.0);
+
+private:
+  void observeAction(const RoundState &before, const RoundState *after, Action::Type action, int opponent);
+
+  std::array<double, NUM_EVENTS> decay;
+  std::array<DecayedRate, NUM_EVENTS> overall;
+  std::array<std::array<std::array<DecayedRate, 2>, 4>, NUM_EVENTS> cells; // [event][street slot][position]
+  std::array<StrengthFit, 4> strengthFits;                                  // [street slot]
+  std::array<int, NUM_EVENTS> runs{};
+};
+
+} // namespace pokerbots::skeleton
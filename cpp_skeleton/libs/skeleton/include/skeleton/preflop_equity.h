@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "equity.h"
+
+namespace pokerbots::skeleton {
+
+// Boards a preflop all-in between two combos runs out to: 48 choose 5.
+inline constexpr std::uint32_t PREFLOP_BOARDS = 1712304;
+
+inline constexpr int NUM_SUIT_PERMUTATIONS = 24;
+
+// combo -> combo under each relabelling of the suits, the identity first.
+using ComboPermutations = std::array<std::array<std::int16_t, NUM_COMBOS>, NUM_SUIT_PERMUTATIONS>;
+
+const ComboPermutations &comboPermutations();
+
+/*
+  Class of the matchup of combo a against combo b under suit relabelling and
+  seat order: the smallest a' * NUM_COMBOS + b' over every relabelling of
+  (a, b) and of (b, a). swapped is set when the class lists b's side first.
+*/
+std::uint32_t canonicalMatchup(int a, int b, bool &swapped);
+
+/*
+  Exact all-in preflop equity of every combo against every other, written by
+  tools/preflop and loaded by the bot.
+
+  The file holds one count per class of matchups that suit relabelling and
+  swapping seats map onto each other, 2 * wins + ties over PREFLOP_BOARDS from
+  the class's first combo's side. Loading expands the classes into a dense
+  NUM_COMBOS x NUM_COMBOS matrix, so equity against a range is one dot product.
+*/
+class PreflopEquity {
+public:
+  bool load(const std::string &path);
+
+  bool save(const std::string &path) const;
+
+  // Takes classes in increasing canonicalMatchup order and expands them.
+  void assign(std::vector<std::uint32_t> classKeys, std::vector<std::uint32_t> classCounts);
+
+  bool loaded() const { return !matrix.empty(); }
+
+  std::size_t numClasses() const { return keys.size(); }
+
+  // Equity of a against b, 0 if they share a card.
+  float equity(int a, int b) const { return matrix[static_cast<std::size_t>(a) * NUM_COMBOS + b]; }
+
+  // Equity of a combo against a range, over the range's combos that share no card with it.
+  double equity(int combo, const Range &range) const;
+
+  // Equity of range a against range b, over the pairs of combos that share no card.
+  double equity(const Range &a, const Range &b) const;
+
+private:
+  void expand();
+
+  // weight of the range's combos sharing a card with combo, the combo itself included
+  static double blockedWeight(int combo, const Range &range);
+
+  std::vector<std::uint32_t> keys; // sorted canonical matchups
+  std::vector<std::uint32_t> counts;
+  std::vector<float> matrix;
+};
+
+} // namespace pokerbots::skeleton
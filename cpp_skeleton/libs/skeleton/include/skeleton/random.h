@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace pokerbots::skeleton {
+
+/*
+  xoshiro256** (Blackman and Vigna): 32 bytes of state and a few cycles per
+  draw, with a jump that skips 2^128 draws so that streams split off one seed
+  never overlap. It meets UniformRandomBitGenerator, so std::shuffle and the
+  std distributions accept it too, but below() and uniform() are cheaper.
+*/
+class Rng {
+public:
+  using result_type = std::uint64_t;
+
+  // The state is filled from seed with splitmix64, so any seed, 0 included, is fine.
+  explicit Rng(std::uint64_t seed = 0) {
+    for (auto &word : state) {
+      seed += 0x9e3779b97f4a7c15ULL;
+      auto z = seed;
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      word = z ^ (z >> 31);
+    }
+  }
+
+  // The index-th of the independent streams of seed, for one thread each.
+  static Rng stream(std::uint64_t seed, unsigned index) {
+    Rng rng(seed);
+    for (unsigned i = 0; i < index; ++i) {
+      rng.jump();
+    }
+    return rng;
+  }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+  result_type operator()() {
+    auto result = rotate(state[1] * 5, 7) * 9;
+    auto t = state[1] << 17;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotate(state[3], 45);
+    return result;
+  }
+
+  // Uniform in [0, bound) without modulo bias, by Lemire's multiply and shift; bound > 0.
+  std::uint32_t below(std::uint32_t bound) {
+    auto product = static_cast<std::uint64_t>((*this)() >> 32) * bound;
+    auto low = static_cast<std::uint32_t>(product);
+    if (low < bound) {
+      auto threshold = static_cast<std::uint32_t>(-bound) % bound;
+      while (low < threshold) {
+        product = static_cast<std::uint64_t>((*this)() >> 32) * bound;
+        low = static_cast<std::uint32_t>(product);
+      }
+    }
+    return static_cast<std::uint32_t>(product >> 32);
+  }
+
+  // Uniform in [lo, hi].
+  int between(int lo, int hi) { return lo + static_cast<int>(below(static_cast<std::uint32_t>(hi - lo + 1))); }
+
+  // Uniform in [0, 1) with 53 random bits.
+  double uniform() { return static_cast<double>((*this)() >> 11) * 0x1.0p-53; }
+
+  // Advances as far as 2^128 draws would.
+  void jump();
+
+private:
+  static std::uint64_t rotate(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+  std::uint64_t state[4];
+};
+
+// The one seed a run derives all its randomness from: POKERBOT_SEED if set, otherwise random.
+std::uint64_t masterSeed();
+
+} // namespace pokerbots::skeleton
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "equity.h"
+#include "game_tree.h"
+#include "states.h"
+#include "thread_pool.h"
+
+namespace pokerbots::skeleton {
+
+// A turn or river decision to re-solve, as seen by `hero`.
+struct SubgameSpot {
+  RoundStatePtr state; // hero to act, board dealt
+  int hero;
+  std::array<int, 2> heroHole;
+  int heroBountyRank;
+  Range heroRange;    // weights of every combo hero could hold here
+  Range villainRange; // weights of every combo the opponent could hold here
+};
+
+struct ResolveOptions {
+  BetAbstraction bets = {{0.5, 1.0}, true, 2};
+  double seconds = 0.05;
+  int maxIterations = 1000;
+  int runoutsPerIteration = 4; // river cards per turn iteration, taken in rotation
+};
+
+struct ResolveResult {
+  std::vector<Action> actions;  // hero's choices at the root
+  std::vector<double> strategy; // average strategy over them for heroHole
+  int iterations = 0;
+};
+
+/*
+  Depth-limited range-vs-range CFR+ on the rest of the current street.
+
+  On the river the tree runs to showdown. On the turn it stops where the river
+  would be dealt and values each leaf by showdown over every river card, i.e.
+  as if both players checked it down; each iteration uses the next block of
+  river cards in rotation so that iterations stay cheap. The opponent's bounty rank is unknown, so
+  their bounty hits with the share of the 13 ranks present in their cards and
+  the board. Showdowns are evaluated with one sorted sweep per board rather than
+  per pair of hands, and turn leaves split their river cards over the pool.
+*/
+ResolveResult resolveSubgame(const SubgameSpot &spot, ThreadPool &pool, const ResolveOptions &options = {});
+
+} // namespace pokerbots::skeleton
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "equity.h"
+
+namespace pokerbots::skeleton {
+
+/*
+  Exact standing of a hand on a complete board against every opponent combo
+  that shares no card with it or the board, at most 990 of them.
+
+  The best five of seven cards is the board, one hole card with four board
+  cards, or both with three, and only the suit the board could make a flush
+  in matters. So hands are evaluated per (rank, flush suit or not) pair of
+  hole cards rather than per combo, a few hundred at most, with the one-card
+  hands shared between them. Counting the combos is then a linear pass.
+*/
+class RiverAnalysis {
+public:
+  struct Share {
+    double win = 0;
+    double tie = 0;
+
+    double equity() const { return win + tie / 2; }
+
+    double notBehind() const { return win + tie; }
+  };
+
+  // board must hold five cards.
+  RiverAnalysis(const std::array<int, 2> &hole, const std::vector<int> &board);
+
+  unsigned short value() const { return ours; }
+
+  int combos() const { return static_cast<int>(values.size()); }
+
+  // 1 for the best hand among ours and every opponent combo; tied hands share a rank.
+  int rank() const { return better + 1; }
+
+  // Share of opponent combos we beat, ties counting half: our exact hand strength against a random hand.
+  double percentile() const;
+
+  // Share of opponent combos we beat or tie.
+  double notBehind() const;
+
+  // Weighted share of the range's live combos that we beat and that we tie.
+  Share against(const Range &range) const;
+
+private:
+  unsigned short ours = 0;
+  int better = 0;
+  int tied = 0;
+  std::vector<std::pair<int, unsigned short>> values; // (combo, hand value) for every live combo
+};
+
+} // namespace pokerbots::skeleton
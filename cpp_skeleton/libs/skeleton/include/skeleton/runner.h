@@ -1,209 +1,390 @@
 #pragma once
 
+#include <unistd.h>
+
 #include <charconv>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
 #include <iostream>
+#include <mutex>
 #include <optional>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <utility>
 #include <map>
 
 #include <boost/algorithm/string.hpp>
-#include <boost/asio/ip/tcp.hpp>
 
 #include "actions.h"
 #include "constants.h"
 #include "game.h"
+#include "showdown_history.h"
 #include "states.h"
+#include "transcript.h"
+#include "transport.h"
 
 namespace pokerbots::skeleton {
 
+// Bots may define handleShowdown(GameInfoPtr, const ShowdownRecord &, int active) to see revealed hands.
+template <typename BotType, typename = void> struct HasShowdownHandler : std::false_type {};
+
+template <typename BotType>
+struct HasShowdownHandler<BotType, std::void_t<decltype(std::declval<BotType &>().handleShowdown(
+                                       std::declval<GameInfoPtr>(), std::declval<const ShowdownRecord &>(), 0))>>
+    : std::true_type {};
+
+// Bots may define handleGameOver(GameInfoPtr) to act once the match has ended.
+template <typename BotType, typename = void> struct HasGameOverHandler : std::false_type {};
+
+template <typename BotType>
+struct HasGameOverHandler<BotType,
+                          std::void_t<decltype(std::declval<BotType &>().handleGameOver(std::declval<GameInfoPtr>()))>>
+    : std::true_type {};
+
+/*
+  Bots may define bool handleIdle(GameInfoPtr, RoundStatePtr, int active) to work while the engine
+  waits on the opponent. It is called with the state after our last action, should do one short
+  slice of work per call and return whether there is more.
+*/
+template <typename BotType, typename = void> struct HasIdleHandler : std::false_type {};
+
+template <typename BotType>
+struct HasIdleHandler<BotType, std::void_t<decltype(std::declval<BotType &>().handleIdle(
+                                   std::declval<GameInfoPtr>(), std::declval<RoundStatePtr>(), 0))>>
+    : std::true_type {};
+
 template <typename BotType> class Runner {
 private:
   BotType pokerbot;
-  boost::asio::ip::tcp::iostream &stream;
+  std::iostream &stream;
+  ShowdownHistory showdowns;
+  GameInfoPtr gameInfo;
+  StatePtr roundState;
+  int active = 0;
+  bool roundFlag = true;
+  TranscriptWriter transcript;
+
+  // packets read ahead by the reader thread, for bots with an idle handler
+  std::mutex inboxMutex;
+  std::condition_variable inboxReady;
+  std::deque<std::string> inbox;
+  bool inputDone = false;
+  RoundStatePtr idleState;
 
+  // One write per reply, so a transport that flushes after every write sends it in one piece.
   template <typename Action> void send(Action const& action) {
-    stream << action << '\n';
+    std::ostringstream line;
+    line << action;
+    if (transcript.isOpen()) {
+      transcript.write(TranscriptEntry::SENT, line.str());
+    }
+    line << '\n';
+    auto text = line.str();
+    stream.write(text.data(), text.size());
   }
 
   std::vector<std::string> receive() {
     std::string line;
     std::getline(stream, line);
     boost::algorithm::trim(line);
+    return received(line);
+  }
 
-    std::vector<std::string> packet;
-    boost::split(packet, line, boost::is_any_of(" "));
-    return packet;
+  std::vector<std::string> received(const std::string &line) {
+    if (transcript.isOpen()) {
+      transcript.write(TranscriptEntry::RECEIVED, line);
+    }
+    return splitPacket(line);
   }
 
-public:
-  template <typename... Args>
-  Runner(boost::asio::ip::tcp::iostream &stream, Args... args)
-      : pokerbot(std::forward<Args>(args)...), stream(stream) {}
+  // Runs on its own thread with its own istream over the connection, until the engine says Q.
+  void readPackets() {
+    std::istream input(stream.rdbuf());
+    std::string line;
+    bool quit = false;
+    while (!quit && std::getline(input, line)) {
+      boost::algorithm::trim(line);
+      // the Q clause alone, not a queen bounty such as GQ
+      quit = line == "Q" || boost::algorithm::ends_with(line, " Q");
+      std::lock_guard<std::mutex> lock(inboxMutex);
+      inbox.push_back(std::move(line));
+      inboxReady.notify_one();
+    }
+    std::lock_guard<std::mutex> lock(inboxMutex);
+    inputDone = true;
+    inboxReady.notify_one();
+  }
+
+  // The next packet, handing the bot idle slices until it arrives; nothing once the connection has ended.
+  std::optional<std::string> nextPacket() {
+    std::unique_lock<std::mutex> lock(inboxMutex);
+    while (inbox.empty() && !inputDone) {
+      if (idleState) {
+        lock.unlock();
+        bool more = pokerbot.handleIdle(gameInfo, idleState, active);
+        // on a single core the reader only gets to take a packet in if we step aside
+        std::this_thread::yield();
+        lock.lock();
+        if (!more) {
+          idleState = nullptr;
+        }
+        continue;
+      }
+      inboxReady.wait(lock);
+    }
+    if (inbox.empty()) {
+      return std::nullopt;
+    }
+    auto line = std::move(inbox.front());
+    inbox.pop_front();
+    return line;
+  }
 
-  ~Runner() { stream.close(); }
+  // The state our reply leads to if the engine accepts it as sent, while the round goes on.
+  RoundStatePtr stateAfter(const Action &reply) const {
+    if (!inRound()) {
+      return nullptr;
+    }
+    auto round = std::static_pointer_cast<const RoundState>(roundState);
+    auto legal = round->legalActions();
+    if (!legal.count(reply.actionType)) {
+      return nullptr;
+    }
+    if (reply.actionType == Action::Type::RAISE) {
+      auto bounds = round->raiseBounds();
+      if (reply.amount < bounds[0] || reply.amount > bounds[1]) {
+        return nullptr;
+      }
+    }
+    return std::dynamic_pointer_cast<const RoundState>(round->proceed(reply));
+  }
 
-  void run() {
-    GameInfoPtr gameInfo = std::make_shared<GameInfo>(0, 0.0, 1);
+public:
+  template <typename... Args>
+  Runner(std::iostream &stream, Args... args)
+      : pokerbot(std::forward<Args>(args)...), stream(stream), gameInfo(std::make_shared<GameInfo>(0, 0.0, 1)) {
     std::array<std::array<std::string, 2>, 2> emptyArray;
     auto emptyBounties = std::array<char, 2>{};
     std::array<std::string, 5> cardDeck;
-    StatePtr roundState = std::make_shared<RoundState>(
+    roundState = std::make_shared<RoundState>(
         0, 0, std::array<int, 2>{0, 0}, std::array<int, 2>{0, 0},
         emptyArray, emptyBounties,
         cardDeck, nullptr);
-    int active = 0;
-    bool roundFlag = true;
-    while (true) {
-      auto packet = receive();
-      for (const auto &clause : packet) {
-        auto leftover = clause.substr(1);
-        switch (clause[0]) {
-          case 'T': {
-            gameInfo = std::make_shared<GameInfo>(gameInfo->bankroll, std::stof(leftover), gameInfo->roundNum);
-            break;
-          }
-          case 'P': {
-            active = std::stoi(leftover);
-            break;
-          }
-          case 'H': {
-            std::vector<std::string> cards;
-            boost::split(cards, leftover, boost::is_any_of(","));
-
-            std::array<std::array<std::string, 2>, 2> hands;
-            hands[active][0] = cards[0];
-            hands[active][1] = cards[1];
-            std::array<std::string, 5> deck;
-            std::array<int, 2> pips = {SMALL_BLIND, BIG_BLIND};
-            std::array<int, 2> stacks = {
-                STARTING_STACK - SMALL_BLIND,
-                STARTING_STACK - BIG_BLIND};
-            std::array<char, 2> bounties;
-            roundState = std::make_shared<RoundState>(
-                0, 0, std::move(pips), std::move(stacks), std::move(hands), std::move(bounties), 
-                    std::move(deck), nullptr);
-            break;
-          }
-          case 'G': {
-            std::array<char, 2> bounties = {' ', ' '};
-            bounties[active] = leftover[0];
-            auto maker = std::static_pointer_cast<const RoundState>(roundState);
-            roundState = std::make_shared<RoundState>(maker->button, maker->street, maker->pips, maker->stacks,
-                                                      maker->hands, bounties, maker->deck, maker->previousState);
-            if (roundFlag) {
-              pokerbot.handleNewRound(
-                  gameInfo,
-                  std::static_pointer_cast<const RoundState>(roundState), active);
-              roundFlag = false;
-            }
-            break;
-          }
-          case 'F': {
-            roundState = std::static_pointer_cast<const RoundState>(roundState)->proceed({Action::Type::FOLD});
-            break;
-          }
-          case 'C': {
-            roundState = std::static_pointer_cast<const RoundState>(roundState)->proceed({Action::Type::CALL});
-            break;
-          }
-          case 'K': {
-            roundState = std::static_pointer_cast<const RoundState>(roundState)->proceed({Action::Type::CHECK});
-            break;
+  }
+
+  BotType &bot() { return pokerbot; }
+
+  static std::vector<std::string> splitPacket(const std::string &line) {
+    std::vector<std::string> packet;
+    boost::split(packet, line, boost::is_any_of(" "));
+    return packet;
+  }
+
+  // Records every packet run() receives and every reply it sends to a binary transcript at path.
+  bool capture(const std::string &path) { return transcript.open(path); }
+
+  const StatePtr &state() const { return roundState; }
+
+  // True while a round is in progress, i.e. when the last reply came from getAction.
+  bool inRound() const { return !roundFlag; }
+
+  /*
+    Applies one packet from the engine to the game state and returns the reply,
+    or nothing once the engine has ended the match. Replays drive the bot
+    through this without a connection.
+  */
+  std::optional<Action> handlePacket(const std::vector<std::string> &packet) {
+    for (const auto &clause : packet) {
+      auto leftover = clause.substr(1);
+      switch (clause[0]) {
+        case 'T': {
+          gameInfo = std::make_shared<GameInfo>(gameInfo->bankroll, std::stof(leftover), gameInfo->roundNum);
+          break;
+        }
+        case 'P': {
+          active = std::stoi(leftover);
+          break;
+        }
+        case 'H': {
+          std::vector<std::string> cards;
+          boost::split(cards, leftover, boost::is_any_of(","));
+
+          std::array<std::array<std::string, 2>, 2> hands;
+          hands[active][0] = cards[0];
+          hands[active][1] = cards[1];
+          std::array<std::string, 5> deck;
+          std::array<int, 2> pips = {SMALL_BLIND, BIG_BLIND};
+          std::array<int, 2> stacks = {
+              STARTING_STACK - SMALL_BLIND,
+              STARTING_STACK - BIG_BLIND};
+          std::array<char, 2> bounties;
+          roundState = std::make_shared<RoundState>(
+              0, 0, std::move(pips), std::move(stacks), std::move(hands), std::move(bounties), 
+                  std::move(deck), nullptr);
+          break;
+        }
+        case 'G': {
+          std::array<char, 2> bounties = {' ', ' '};
+          bounties[active] = leftover[0];
+          auto maker = std::static_pointer_cast<const RoundState>(roundState);
+          roundState = std::make_shared<RoundState>(maker->button, maker->street, maker->pips, maker->stacks,
+                                                    maker->hands, bounties, maker->deck, maker->previousState);
+          if (roundFlag) {
+            pokerbot.handleNewRound(
+                gameInfo,
+                std::static_pointer_cast<const RoundState>(roundState), active);
+            roundFlag = false;
           }
-          case 'R': {
-            roundState = std::static_pointer_cast<const RoundState>(roundState)->proceed({Action::Type::RAISE,
-                                                                                          std::stoi(leftover)});
-            break;
+          break;
+        }
+        case 'F': {
+          roundState = std::static_pointer_cast<const RoundState>(roundState)->proceed({Action::Type::FOLD});
+          break;
+        }
+        case 'C': {
+          roundState = std::static_pointer_cast<const RoundState>(roundState)->proceed({Action::Type::CALL});
+          break;
+        }
+        case 'K': {
+          roundState = std::static_pointer_cast<const RoundState>(roundState)->proceed({Action::Type::CHECK});
+          break;
+        }
+        case 'R': {
+          roundState = std::static_pointer_cast<const RoundState>(roundState)->proceed({Action::Type::RAISE,
+                                                                                        std::stoi(leftover)});
+          break;
+        }
+        case 'B': {
+          std::vector<std::string> cards;
+          boost::split(cards, leftover, boost::is_any_of(","));
+          std::array<std::string, 5> revisedDeck;
+          for (auto j = 0; j < cards.size(); ++j) {
+            revisedDeck[j] = cards[j];
           }
-          case 'B': {
-            std::vector<std::string> cards;
-            boost::split(cards, leftover, boost::is_any_of(","));
-            std::array<std::string, 5> revisedDeck;
-            for (auto j = 0; j < cards.size(); ++j) {
-              revisedDeck[j] = cards[j];
+          auto maker = std::static_pointer_cast<const RoundState>(roundState);
+          roundState = std::make_shared<RoundState>(maker->button, maker->street, maker->pips, maker->stacks,
+                                                    maker->hands, maker->bounties, revisedDeck, maker->previousState);
+          break;
+        }
+        case 'O': {
+          // backtrack
+          std::vector<std::string> cards;
+          boost::split(cards, leftover, boost::is_any_of(","));
+          roundState = std::static_pointer_cast<const TerminalState>(roundState)->previousState;
+          auto maker = std::static_pointer_cast<const RoundState>(roundState);
+          auto revisedHands = maker->hands;
+          revisedHands[1 - active] = {cards[0], cards[1]};
+          // rebuild history
+          roundState = std::make_shared<RoundState>(maker->button, maker->street, maker->pips, maker->stacks,
+                                                    revisedHands, maker->bounties, maker->deck, maker->previousState);
+          roundState = std::make_shared<TerminalState>(std::array<int, 2>{0, 0}, std::array<bool, 2>{false, false}, roundState);
+          if (showdowns.record(*std::static_pointer_cast<const TerminalState>(roundState), active,
+                               gameInfo->roundNum)) {
+            if constexpr (HasShowdownHandler<BotType>::value) {
+              pokerbot.handleShowdown(gameInfo, showdowns.back(), active);
             }
-            auto maker = std::static_pointer_cast<const RoundState>(roundState);
-            roundState = std::make_shared<RoundState>(maker->button, maker->street, maker->pips, maker->stacks,
-                                                      maker->hands, maker->bounties, revisedDeck, maker->previousState);
-            break;
-          }
-          case 'O': {
-            // backtrack
-            std::vector<std::string> cards;
-            boost::split(cards, leftover, boost::is_any_of(","));
-            roundState = std::static_pointer_cast<const TerminalState>(roundState)->previousState;
-            auto maker = std::static_pointer_cast<const RoundState>(roundState);
-            auto revisedHands = maker->hands;
-            revisedHands[1 - active] = {cards[0], cards[1]};
-            // rebuild history
-            roundState = std::make_shared<RoundState>(maker->button, maker->street, maker->pips, maker->stacks,
-                                                      revisedHands, maker->bounties, maker->deck, maker->previousState);
-            roundState = std::make_shared<TerminalState>(std::array<int, 2>{0, 0}, std::array<bool, 2>{false, false}, roundState);
-            break;
-          }
-          case 'D': {
-            auto delta = std::stoi(leftover);
-            std::array<int, 2> deltas;
-            deltas[active] = delta;
-            deltas[1 - active] = -1 * delta;
-            roundState = std::make_shared<TerminalState>(
-                std::move(deltas),
-                std::array<bool, 2>{false, false},
-                std::static_pointer_cast<const TerminalState>(roundState)
-                    ->previousState);
-            gameInfo = std::make_shared<GameInfo>(
-                gameInfo->bankroll + delta, gameInfo->gameClock, gameInfo->roundNum);
-            break;
-          }
-          case 'Y': {
-            std::array<bool, 2> bounty_hits = {leftover[0] == '1', leftover[1] == '1'};
-            if(active == 1) std::swap(bounty_hits[0], bounty_hits[1]);
-            roundState = std::make_shared<TerminalState>(
-                std::static_pointer_cast<const TerminalState>(roundState)->deltas,
-                bounty_hits,
-                std::static_pointer_cast<const TerminalState>(roundState)->previousState);
-            pokerbot.handleRoundOver(
-                gameInfo,
-                std::static_pointer_cast<const TerminalState>(roundState),
-                active);
-            gameInfo = std::make_shared<GameInfo>(
-                gameInfo->bankroll, gameInfo->gameClock, gameInfo->roundNum + 1);
-            roundFlag = true;
-            break;
           }
-          case 'Q': {
-            return;
-          }
-          default: {
-            break;
+          break;
+        }
+        case 'D': {
+          auto delta = std::stoi(leftover);
+          std::array<int, 2> deltas;
+          deltas[active] = delta;
+          deltas[1 - active] = -1 * delta;
+          roundState = std::make_shared<TerminalState>(
+              std::move(deltas),
+              std::array<bool, 2>{false, false},
+              std::static_pointer_cast<const TerminalState>(roundState)
+                  ->previousState);
+          gameInfo = std::make_shared<GameInfo>(
+              gameInfo->bankroll + delta, gameInfo->gameClock, gameInfo->roundNum);
+          break;
+        }
+        case 'Y': {
+          std::array<bool, 2> bounty_hits = {leftover[0] == '1', leftover[1] == '1'};
+          if(active == 1) std::swap(bounty_hits[0], bounty_hits[1]);
+          roundState = std::make_shared<TerminalState>(
+              std::static_pointer_cast<const TerminalState>(roundState)->deltas,
+              bounty_hits,
+              std::static_pointer_cast<const TerminalState>(roundState)->previousState);
+          pokerbot.handleRoundOver(
+              gameInfo,
+              std::static_pointer_cast<const TerminalState>(roundState),
+              active);
+          gameInfo = std::make_shared<GameInfo>(
+              gameInfo->bankroll, gameInfo->gameClock, gameInfo->roundNum + 1);
+          roundFlag = true;
+          break;
+        }
+        case 'Q': {
+          if constexpr (HasGameOverHandler<BotType>::value) {
+            pokerbot.handleGameOver(gameInfo);
           }
+          return std::nullopt;
+        }
+        default: {
+          break;
         }
       }
-      if (roundFlag) {
-        send(Action {Action::Type::CHECK});
-      } else {
-        auto action = pokerbot.getAction(gameInfo, std::static_pointer_cast<const RoundState>(roundState), active);
-        send(action);
+    }
+    if (roundFlag) {
+      return Action{Action::Type::CHECK};
+    }
+    return pokerbot.getAction(gameInfo, std::static_pointer_cast<const RoundState>(roundState), active);
+  }
+
+  /*
+    Plays until the engine ends the match. For bots with an idle handler, reads
+    block on a separate thread so that the time between our reply and the next
+    packet, which the engine does not charge us for, goes to handleIdle.
+  */
+  void run() {
+    if constexpr (HasIdleHandler<BotType>::value) {
+      std::thread reader([this]() { readPackets(); });
+      while (auto line = nextPacket()) {
+        auto reply = handlePacket(received(*line));
+        if (!reply) {
+          break;
+        }
+        send(*reply);
+        idleState = stateAfter(*reply);
+      }
+      reader.join();
+    } else {
+      while (auto reply = handlePacket(receive())) {
+        send(*reply);
       }
     }
+    transcript.close();
   }
 };
 
+template <typename BotType, typename... Args>
+void runBot(Transport &transport, Args... args) {
+  auto r = Runner<BotType>(transport.stream(), std::forward<Args>(args)...);
+  // opt in with POKERBOT_TRANSCRIPT=directory, one file per process since both seats share the environment
+  if (auto directory = std::getenv("POKERBOT_TRANSCRIPT"); directory && *directory) {
+    auto path = std::string(directory) + "/transcript-" + std::to_string(getpid()) + ".bin";
+    if (!r.capture(path)) {
+      std::cerr << "Unable to write transcript " << path << std::endl;
+    }
+  }
+  r.run();
+  transport.close();
+}
+
+// Connects over TCP as the engine expects, or over a Unix socket when host is "unix:<path>".
 template <typename BotType, typename... Args>
 void runBot(std::string &host, std::string &port, Args... args) {
-  boost::asio::ip::tcp::iostream stream;
-  stream.connect(host, port);
-  // set TCP_NODELAY on the stream
-  boost::asio::ip::tcp::no_delay option(true);
-  stream.rdbuf()->socket().set_option(option);
-  if (!stream) {
+  auto transport = connectTransport(host, port);
+  if (!transport) {
     std::cerr << "Unable to connect to " << host << ":" << port << std::endl;
     return;
   }
-
-  auto r = Runner<BotType>(stream, std::forward<Args>(args)...);
-  r.run();
+  runBot<BotType>(*transport, std::forward<Args>(args)...);
 }
 
 inline std::array<std::string, 2> parseArgs(int argc, char *argv[]) {
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "game_tree.h"
+
+namespace pokerbots::skeleton {
+
+// Information sets are (decision node, card bucket, own bounty hit so far).
+struct InfoSetLayout {
+  InfoSetLayout(const GameTree &tree, std::array<int, 4> buckets);
+
+  std::size_t index(int node, int bucket, bool bountyHit) const {
+    return offsets[node] + (2 * static_cast<std::size_t>(bucket) + bountyHit) * width[node];
+  }
+
+  std::size_t size() const { return total; }
+
+  std::array<int, 4> buckets;
+  std::vector<std::size_t> offsets;
+  std::vector<std::uint8_t> width; // number of actions, zero for terminal nodes
+  std::size_t total = 0;
+};
+
+// Probabilities of one info set as bytes summing to QUANTIZED_TOTAL.
+inline constexpr int QUANTIZED_TOTAL = 255;
+
+void quantizeStrategy(const double *probabilities, int actions, std::uint8_t *out);
+
+// bucketedStreets has a bit per street slot that was bucketed by the bucket table rather than the fallback.
+bool writeStrategyTable(const std::string &path, const BetAbstraction &bets, const std::array<int, 4> &buckets,
+                        int fallbackBuckets, std::uint8_t bucketedStreets, const std::vector<std::uint8_t> &quantized);
+
+/*
+  Blueprint strategy written by the solver, one byte per action.
+
+  The file is memory mapped rather than read, so load time does not depend on
+  its size and only the pages the bot actually visits are ever faulted in. The
+  betting tree is rebuilt from the bet abstraction in the header, and the card
+  abstraction from the fallback size and bucketed streets stored with it.
+*/
+class StrategyTable {
+public:
+  StrategyTable() = default;
+  StrategyTable(const StrategyTable &) = delete;
+  StrategyTable &operator=(const StrategyTable &) = delete;
+  ~StrategyTable();
+
+  bool load(const std::string &path);
+
+  bool empty() const { return probabilities == nullptr; }
+
+  const GameTree &tree() const { return *gameTree; }
+
+  const std::array<int, 4> &buckets() const { return layout->buckets; }
+
+  int fallbackBuckets() const { return fallback; }
+
+  std::uint8_t bucketedStreets() const { return bucketed; }
+
+  // Quantized probabilities in the order of the node's children.
+  const std::uint8_t *strategy(int node, int bucket, bool bountyHit) const {
+    return probabilities + layout->index(node, bucket, bountyHit);
+  }
+
+  // Index of a child of `node` drawn with `uniform` in [0, QUANTIZED_TOTAL).
+  int sample(int node, int bucket, bool bountyHit, int uniform) const {
+    auto weights = strategy(node, bucket, bountyHit);
+    int actions = layout->width[node];
+    int chosen = 0;
+    for (int cumulative = weights[0]; chosen + 1 < actions && cumulative <= uniform;
+         cumulative += weights[++chosen]) {
+    }
+    return chosen;
+  }
+
+private:
+  void unmap();
+
+  std::unique_ptr<GameTree> gameTree;
+  std::unique_ptr<InfoSetLayout> layout;
+  void *mapping = nullptr;
+  std::size_t mappingSize = 0;
+  const std::uint8_t *probabilities = nullptr;
+  int fallback = 0;
+  std::uint8_t bucketed = 0;
+};
+
+} // namespace pokerbots::skeleton
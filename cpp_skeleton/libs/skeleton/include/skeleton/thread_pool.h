@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pokerbots::skeleton {
+
+// Fixed set of worker threads. Jobs receive the index of the worker running them
+// so callers can keep per-worker scratch space without locking.
+class ThreadPool {
+public:
+  // 0 means one worker per hardware thread
+  explicit ThreadPool(unsigned threads = 0);
+
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  unsigned size() const { return static_cast<unsigned>(workers.size()); }
+
+  void submit(std::function<void(unsigned)> job);
+
+  // Blocks until every job submitted so far has finished.
+  void wait();
+
+  // Runs fn(index, worker) for every index in [0, count) and blocks until done.
+  template <typename Fn> void parallelFor(std::size_t count, Fn &&fn) {
+    std::atomic<std::size_t> next{0};
+    for (unsigned w = 0; w < size(); ++w) {
+      submit([&](unsigned worker) {
+        for (auto i = next++; i < count; i = next++) {
+          fn(i, worker);
+        }
+      });
+    }
+    wait();
+  }
+
+private:
+  void work(unsigned worker);
+
+  std::vector<std::thread> workers;
+  std::deque<std::function<void(unsigned)>> jobs;
+  std::mutex mutex;
+  std::condition_variable jobReady;
+  std::condition_variable jobsDone;
+  std::size_t running = 0;
+  bool stopping = false;
+};
+
+} // namespace pokerbots::skeleton
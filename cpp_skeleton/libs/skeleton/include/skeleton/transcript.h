@@ -0,0 +1,44 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace pokerbots::skeleton {
+
+// One line of the protocol as the runner saw it.
+struct TranscriptEntry {
+  enum Direction : std::uint8_t { RECEIVED, SENT };
+
+  Direction direction;
+  std::uint64_t nanoseconds; // since the transcript was opened
+  std::string line;
+};
+
+/*
+  Binary log of every packet the runner receives and every action it sends,
+  timestamped against a monotonic clock. Entries go through the file
+  stream's buffer, so capturing costs a copy per packet rather than a system
+  call.
+*/
+class TranscriptWriter {
+public:
+  bool open(const std::string &path);
+
+  bool isOpen() const { return out.is_open(); }
+
+  void write(TranscriptEntry::Direction direction, const std::string &line);
+
+  void close();
+
+private:
+  std::ofstream out;
+  std::chrono::steady_clock::time_point start;
+};
+
+// Reads a whole transcript, returns false if the file is missing or not a transcript.
+bool readTranscript(const std::string &path, std::vector<TranscriptEntry> &entries);
+
+} // namespace pokerbots::skeleton
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace pokerbots::skeleton {
+
+/*
+  A connection between the runner and an engine, seen as a line-oriented
+  stream. Every transport flushes after each write, as the runner expects,
+  and is full duplex: one thread may block reading while another writes.
+*/
+class Transport {
+public:
+  virtual ~Transport() = default;
+
+  virtual std::iostream &stream() = 0;
+
+  // Ends the connection; the other side reads end of file once it has drained what was sent.
+  virtual void close() = 0;
+};
+
+using TransportPtr = std::unique_ptr<Transport>;
+
+// TCP with Nagle disabled, what the tournament engine expects; null if the connection failed.
+TransportPtr connectTcp(const std::string &host, const std::string &port);
+
+// Unix domain socket at path; null if the connection failed.
+TransportPtr connectUnix(const std::string &path);
+
+// A host of the form "unix:<path>" selects a Unix domain socket, anything else TCP.
+TransportPtr connectTransport(const std::string &host, const std::string &port);
+
+// Both ends of a connected Unix domain socket pair.
+std::pair<TransportPtr, TransportPtr> unixSocketPair();
+
+/*
+  Both ends of an in-process connection made of two single-producer,
+  single-consumer byte rings, for a runner and a driver on different threads
+  of one process. Readers spin briefly before sleeping, so replies cross
+  without a system call while both threads are busy.
+*/
+std::pair<TransportPtr, TransportPtr> inProcessPair(std::size_t capacity = 1 << 16);
+
+} // namespace pokerbots::skeleton
@@ -0,0 +1,184 @@
+#include "skeleton/buckets.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+#include "skeleton/binary_io.h"
+#include "skeleton/card_set.h"
+
+namespace pokerbots::skeleton {
+
+namespace {
+
+constexpr std::uint32_t BUCKET_MAGIC = 0x4B425042; // "PBBK"
+constexpr std::uint32_t BUCKET_VERSION = 1;
+
+// fallback sample size for situations missing from the table
+constexpr int LOOKUP_RUNOUTS = 32;
+constexpr int LOOKUP_OPPONENTS = 8;
+constexpr std::size_t FALLBACK_CAPACITY = 1 << 16;
+
+} // namespace
+
+std::uint64_t canonicalSituation(const std::array<int, 2> &hole, const std::vector<int> &board) {
+  constexpr std::uint64_t ABSENT = 63;
+  std::array<int, NUM_SUITS> permutation = {0, 1, 2, 3};
+  auto best = std::numeric_limits<std::uint64_t>::max();
+  do {
+    auto relabel = [&](int card) { return cardIndex(rankOf(card), permutation[suitOf(card)]); };
+    int h[2] = {relabel(hole[0]), relabel(hole[1])};
+    if (h[0] > h[1]) {
+      std::swap(h[0], h[1]);
+    }
+    std::uint64_t slots[5] = {ABSENT, ABSENT, ABSENT, ABSENT, ABSENT};
+    for (std::size_t i = 0; i < board.size() && i < 5; ++i) {
+      slots[i] = relabel(board[i]);
+    }
+    // the flop comes unordered; three compare-and-swaps sort it
+    if (board.size() >= 3) {
+      auto order = [&](int i, int j) {
+        if (slots[i] > slots[j]) {
+          std::swap(slots[i], slots[j]);
+        }
+      };
+      order(0, 1);
+      order(1, 2);
+      order(0, 1);
+    }
+
+    std::uint64_t key = static_cast<std::uint64_t>(h[0]) << 6 | static_cast<std::uint64_t>(h[1]);
+    for (auto slot : slots) {
+      key = key << 6 | slot;
+    }
+    best = std::min(best, key);
+  } while (std::next_permutation(permutation.begin(), permutation.end()));
+  return best;
+}
+
+std::vector<float> equityHistogram(const std::array<int, 2> &hole, const std::vector<int> &board,
+                                   int bins, int runouts, int opponents, Rng &rng) {
+  auto dead = CardSet{hole[0], hole[1]} | CardSet::of(board);
+  std::array<int, NUM_CARDS> deck;
+  int deckSize = (CardSet::deck() - dead).indices(deck.data());
+  auto draw = [&](int position) {
+    std::swap(deck[position], deck[rng.between(position, deckSize - 1)]);
+    return deck[position];
+  };
+
+  int boardSize = static_cast<int>(board.size());
+  int toDeal = 5 - boardSize;
+  int ours[7] = {hole[0], hole[1]};
+  int theirs[7];
+  for (int i = 0; i < boardSize; ++i) {
+    ours[2 + i] = theirs[2 + i] = board[i];
+  }
+
+  std::vector<float> histogram(bins, 0.0f);
+  for (int r = 0; r < runouts; ++r) {
+    for (int i = 0; i < toDeal; ++i) {
+      ours[2 + boardSize + i] = theirs[2 + boardSize + i] = draw(i);
+    }
+    auto value = evalIndices(ours, 7);
+    double strength = 0;
+    for (int k = 0; k < opponents; ++k) {
+      theirs[0] = draw(toDeal);
+      theirs[1] = draw(toDeal + 1);
+      auto theirValue = evalIndices(theirs, 7);
+      strength += value < theirValue ? 1.0 : (value == theirValue ? 0.5 : 0.0);
+    }
+    strength /= opponents;
+    auto bin = std::min(bins - 1, static_cast<int>(strength * bins));
+    histogram[bin] += 1.0f / runouts;
+  }
+  return histogram;
+}
+
+float earthMoversDistance(const float *a, const float *b, int bins) {
+  // in one dimension EMD is the L1 distance between the cumulative distributions
+  float carried = 0;
+  float distance = 0;
+  for (int i = 0; i < bins; ++i) {
+    carried += a[i] - b[i];
+    distance += std::fabs(carried);
+  }
+  return distance;
+}
+
+int StreetBuckets::nearest(const float *histogram) const {
+  int best = 0;
+  auto bestDistance = std::numeric_limits<float>::max();
+  for (int b = 0; b < buckets; ++b) {
+    auto distance = earthMoversDistance(histogram, &centroids[b * bins], bins);
+    if (distance < bestDistance) {
+      bestDistance = distance;
+      best = b;
+    }
+  }
+  return best;
+}
+
+BucketTable::BucketTable() : fallback(std::make_unique<ConcurrentCache<std::int32_t>>(FALLBACK_CAPACITY)) {}
+
+bool BucketTable::load(const std::string &path) {
+  fallback = std::make_unique<ConcurrentCache<std::int32_t>>(FALLBACK_CAPACITY);
+  std::ifstream in(path, std::ios::binary);
+  std::uint32_t magic = 0;
+  std::uint32_t version = 0;
+  if (!readValue(in, magic) || !readValue(in, version) || magic != BUCKET_MAGIC || version != BUCKET_VERSION) {
+    return false;
+  }
+  for (auto &street : streets) {
+    std::uint32_t buckets = 0;
+    std::uint32_t bins = 0;
+    std::uint64_t entries = 0;
+    if (!readValue(in, buckets) || !readValue(in, bins) || !readValue(in, entries) ||
+        !readVector(in, street.centroids, static_cast<std::uint64_t>(buckets) * bins) ||
+        !readVector(in, street.keys, entries) || !readVector(in, street.assignment, entries)) {
+      streets = {};
+      return false;
+    }
+    street.buckets = static_cast<int>(buckets);
+    street.bins = static_cast<int>(bins);
+  }
+  return true;
+}
+
+bool BucketTable::save(const std::string &path) const {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  writeValue(out, BUCKET_MAGIC);
+  writeValue(out, BUCKET_VERSION);
+  for (const auto &street : streets) {
+    writeValue(out, static_cast<std::uint32_t>(street.buckets));
+    writeValue(out, static_cast<std::uint32_t>(street.bins));
+    writeValue(out, static_cast<std::uint64_t>(street.keys.size()));
+    writeVector(out, street.centroids);
+    writeVector(out, street.keys);
+    writeVector(out, street.assignment);
+  }
+  return static_cast<bool>(out);
+}
+
+int BucketTable::bucket(const std::array<int, 2> &hole, const std::vector<int> &board,
+                        Rng &rng) const {
+  const auto &street = streets[streetSlot(static_cast<int>(board.size()))];
+  if (street.buckets == 0) {
+    return -1;
+  }
+  auto key = canonicalSituation(hole, board);
+  auto it = std::lower_bound(street.keys.begin(), street.keys.end(), key);
+  if (it != street.keys.end() && *it == key) {
+    return street.assignment[it - street.keys.begin()];
+  }
+  std::int32_t cached;
+  if (fallback->find(key, cached)) {
+    return cached;
+  }
+  auto histogram = equityHistogram(hole, board, street.bins, LOOKUP_RUNOUTS, LOOKUP_OPPONENTS, rng);
+  auto nearest = street.nearest(histogram.data());
+  fallback->insert(key, nearest);
+  return nearest;
+}
+
+} // namespace pokerbots::skeleton
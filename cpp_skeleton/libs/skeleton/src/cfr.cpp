@@ -0,0 +1,291 @@
+#include "skeleton/cfr.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#include "skeleton/binary_io.h"
+#include "skeleton/equity.h"
+
+namespace pokerbots::skeleton {
+
+namespace {
+
+constexpr std::uint32_t CHECKPOINT_MAGIC = 0x46434250; // "PBCF"
+constexpr std::uint32_t FORMAT_VERSION = 1;
+constexpr int MAX_ACTIONS = 16;
+constexpr int WORST_HAND = 7462;
+
+inline void addRelaxed(std::atomic<float> &target, float value) {
+  auto current = target.load(std::memory_order_relaxed);
+  while (!target.compare_exchange_weak(current, current + value, std::memory_order_relaxed)) {
+  }
+}
+
+// Regret matching over the positive regrets, uniform if there are none.
+inline void regretMatching(const std::atomic<float> *regrets, int actions, double *strategy) {
+  double total = 0;
+  for (int a = 0; a < actions; ++a) {
+    strategy[a] = std::max(0.0f, regrets[a].load(std::memory_order_relaxed));
+    total += strategy[a];
+  }
+  for (int a = 0; a < actions; ++a) {
+    strategy[a] = total > 0 ? strategy[a] / total : 1.0 / actions;
+  }
+}
+
+} // namespace
+
+CardAbstraction::CardAbstraction(const BucketTable *table, int fallbackBuckets, std::uint8_t streets)
+    : table(table), fallbackBuckets(fallbackBuckets), streets(streets) {
+  for (const auto &combo : COMBO_CARDS) {
+    preflopClasses.push_back(canonicalSituation({combo.first, combo.second}, {}));
+  }
+  std::sort(preflopClasses.begin(), preflopClasses.end());
+  preflopClasses.erase(std::unique(preflopClasses.begin(), preflopClasses.end()), preflopClasses.end());
+}
+
+bool CardAbstraction::usesTable(int street) const {
+  return table && (streets >> streetSlot(street) & 1) && table->hasStreet(street);
+}
+
+std::uint8_t CardAbstraction::bucketedStreets() const {
+  std::uint8_t bucketed = 0;
+  for (int street : {0, 3, 4, 5}) {
+    bucketed |= static_cast<std::uint8_t>(usesTable(street) << streetSlot(street));
+  }
+  return bucketed;
+}
+
+int CardAbstraction::numBuckets(int street) const {
+  if (usesTable(street)) {
+    return table->numBuckets(street);
+  }
+  return street == 0 ? static_cast<int>(preflopClasses.size()) : fallbackBuckets;
+}
+
+int CardAbstraction::bucket(const std::array<int, 2> &hole, const std::vector<int> &board,
+                            Rng &rng) const {
+  auto street = static_cast<int>(board.size());
+  if (usesTable(street)) {
+    return table->bucket(hole, board, rng);
+  }
+  if (street == 0) {
+    auto key = canonicalSituation(hole, board);
+    return static_cast<int>(std::lower_bound(preflopClasses.begin(), preflopClasses.end(), key) -
+                            preflopClasses.begin());
+  }
+  int cards[7] = {hole[0], hole[1]};
+  std::copy(board.begin(), board.end(), cards + 2);
+  auto value = evalIndices(cards, 2 + street);
+  return std::min(fallbackBuckets - 1, (WORST_HAND - value) * fallbackBuckets / WORST_HAND);
+}
+
+Solver::Solver(const GameTree &tree, const CardAbstraction &cards)
+    : tree(tree), cards(cards),
+      layout(tree, {cards.numBuckets(0), cards.numBuckets(3), cards.numBuckets(4), cards.numBuckets(5)}),
+      regrets(new std::atomic<float>[layout.size()]),
+      strategySums(new std::atomic<float>[layout.size()]) {
+  for (std::size_t i = 0; i < layout.size(); ++i) {
+    regrets[i].store(0.0f, std::memory_order_relaxed);
+    strategySums[i].store(0.0f, std::memory_order_relaxed);
+  }
+}
+
+Solver::Deal Solver::deal(Rng &rng) const {
+  Deal d;
+  std::array<int, NUM_CARDS> deck;
+  for (int card = 0; card < NUM_CARDS; ++card) {
+    deck[card] = card;
+  }
+  for (int i = 0; i < 9; ++i) {
+    std::swap(deck[i], deck[rng.between(i, NUM_CARDS - 1)]);
+  }
+  d.hole = {{{deck[0], deck[1]}, {deck[2], deck[3]}}};
+  std::copy(deck.begin() + 4, deck.begin() + 9, d.board.begin());
+
+  for (int player = 0; player < 2; ++player) {
+    int bounty = rng.between(0, NUM_RANKS - 1);
+    bool hit = rankOf(d.hole[player][0]) == bounty || rankOf(d.hole[player][1]) == bounty;
+    int seen = 0;
+    for (int slot = 0; slot < 4; ++slot) {
+      int boardSize = slot == 0 ? 0 : slot + 2;
+      for (; seen < boardSize; ++seen) {
+        hit = hit || rankOf(d.board[seen]) == bounty;
+      }
+      d.bountyHit[player][slot] = hit;
+      std::vector<int> board(d.board.begin(), d.board.begin() + boardSize);
+      d.buckets[player][slot] = cards.bucket(d.hole[player], board, rng);
+    }
+  }
+
+  int cards0[7] = {d.hole[0][0], d.hole[0][1]};
+  int cards1[7] = {d.hole[1][0], d.hole[1][1]};
+  std::copy(d.board.begin(), d.board.end(), cards0 + 2);
+  std::copy(d.board.begin(), d.board.end(), cards1 + 2);
+  auto value0 = evalIndices(cards0, 7);
+  auto value1 = evalIndices(cards1, 7);
+  d.winner = value0 < value1 ? 0 : (value0 > value1 ? 1 : 2);
+  return d;
+}
+
+double Solver::payoff(const GameNode &node, const Deal &deal, int player) const {
+  auto slot = streetSlot(node.street);
+  int winner = node.kind == GameNode::FOLD ? 1 - node.player : deal.winner;
+  if (winner == 2) {
+    bool hit0 = deal.bountyHit[0][slot];
+    bool hit1 = deal.bountyHit[1][slot];
+    if (hit0 == hit1) {
+      return 0;
+    }
+    double bonus = node.contributions[0] * (BOUNTY_RATIO - 1) / 2 + BOUNTY_CONSTANT;
+    return (hit0 == (player == 0)) ? bonus : -bonus;
+  }
+  double amount = node.contributions[1 - winner];
+  if (deal.bountyHit[winner][slot]) {
+    amount = amount * BOUNTY_RATIO + BOUNTY_CONSTANT;
+  }
+  return player == winner ? amount : -amount;
+}
+
+double Solver::traverse(int index, int traverser, const Deal &deal, Rng &rng) {
+  const auto &node = tree.node(index);
+  if (node.kind != GameNode::DECISION) {
+    return payoff(node, deal, traverser);
+  }
+  int player = node.player;
+  auto slot = streetSlot(node.street);
+  auto infoSet = layout.index(index, deal.buckets[player][slot], deal.bountyHit[player][slot]);
+  int actions = node.numActions;
+  double strategy[MAX_ACTIONS];
+  regretMatching(&regrets[infoSet], actions, strategy);
+
+  if (player == traverser) {
+    double values[MAX_ACTIONS];
+    double expected = 0;
+    for (int a = 0; a < actions; ++a) {
+      values[a] = traverse(tree.child(index, a), traverser, deal, rng);
+      expected += strategy[a] * values[a];
+    }
+    for (int a = 0; a < actions; ++a) {
+      addRelaxed(regrets[infoSet + a], static_cast<float>(values[a] - expected));
+    }
+    return expected;
+  }
+
+  // the opponent's average strategy is accumulated where it is sampled
+  for (int a = 0; a < actions; ++a) {
+    addRelaxed(strategySums[infoSet + a], static_cast<float>(strategy[a]));
+  }
+  double target = rng.uniform();
+  int chosen = 0;
+  for (; chosen + 1 < actions; ++chosen) {
+    target -= strategy[chosen];
+    if (target <= 0) {
+      break;
+    }
+  }
+  return traverse(tree.child(index, chosen), traverser, deal, rng);
+}
+
+void Solver::run(std::uint64_t iterations, ThreadPool &pool, unsigned seed,
+                 std::uint64_t checkpointInterval, const std::string &checkpointPath) {
+  // one stream per worker, fresh ones after resuming from a checkpoint
+  std::vector<Rng> rngs;
+  for (unsigned w = 0; w < pool.size(); ++w) {
+    rngs.push_back(Rng::stream(seed + 104729 * completed, w));
+  }
+  auto batch = checkpointInterval > 0 ? checkpointInterval : iterations;
+  for (std::uint64_t done = 0; done < iterations;) {
+    auto count = std::min(batch, iterations - done);
+    pool.parallelFor(count, [&](std::size_t, unsigned worker) {
+      for (int traverser = 0; traverser < 2; ++traverser) {
+        auto d = deal(rngs[worker]);
+        traverse(GameTree::root(), traverser, d, rngs[worker]);
+      }
+    });
+    done += count;
+    completed += count;
+    if (checkpointInterval > 0 && !checkpointPath.empty()) {
+      if (saveCheckpoint(checkpointPath)) {
+        std::cout << "Checkpoint at iteration " << completed << std::endl;
+      } else {
+        std::cerr << "Unable to write checkpoint " << checkpointPath << std::endl;
+      }
+    }
+  }
+}
+
+bool Solver::saveCheckpoint(const std::string &path) const {
+  // write next to the target and rename, so an interrupted write keeps the old checkpoint
+  auto temporary = path + ".tmp";
+  {
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    writeValue(out, CHECKPOINT_MAGIC);
+    writeValue(out, FORMAT_VERSION);
+    writeValue(out, static_cast<std::uint64_t>(layout.size()));
+    writeValue(out, completed);
+    for (std::size_t i = 0; i < layout.size(); ++i) {
+      writeValue(out, regrets[i].load(std::memory_order_relaxed));
+    }
+    for (std::size_t i = 0; i < layout.size(); ++i) {
+      writeValue(out, strategySums[i].load(std::memory_order_relaxed));
+    }
+    if (!out) {
+      return false;
+    }
+  }
+  return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+bool Solver::loadCheckpoint(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  std::uint32_t magic = 0;
+  std::uint32_t version = 0;
+  std::uint64_t size = 0;
+  std::uint64_t iterations = 0;
+  if (!readValue(in, magic) || !readValue(in, version) || magic != CHECKPOINT_MAGIC ||
+      version != FORMAT_VERSION || !readValue(in, size) || size != layout.size() ||
+      !readValue(in, iterations)) {
+    return false;
+  }
+  std::vector<float> values;
+  if (!readVector(in, values, 2 * size)) {
+    return false;
+  }
+  for (std::size_t i = 0; i < size; ++i) {
+    regrets[i].store(values[i], std::memory_order_relaxed);
+    strategySums[i].store(values[size + i], std::memory_order_relaxed);
+  }
+  completed = iterations;
+  return true;
+}
+
+bool Solver::exportStrategy(const std::string &path) const {
+  std::vector<std::uint8_t> quantized(layout.size());
+  for (int n = 0; n < tree.size(); ++n) {
+    int actions = layout.width[n];
+    if (actions == 0) {
+      continue;
+    }
+    auto sets = 2 * static_cast<std::size_t>(layout.buckets[streetSlot(tree.node(n).street)]);
+    for (std::size_t s = 0; s < sets; ++s) {
+      auto base = layout.offsets[n] + s * actions;
+      double average[MAX_ACTIONS];
+      double total = 0;
+      for (int a = 0; a < actions; ++a) {
+        average[a] = strategySums[base + a].load(std::memory_order_relaxed);
+        total += average[a];
+      }
+      for (int a = 0; a < actions; ++a) {
+        average[a] = total > 0 ? average[a] / total : 1.0 / actions;
+      }
+      quantizeStrategy(average, actions, &quantized[base]);
+    }
+  }
+  return writeStrategyTable(path, tree.abstraction(), layout.buckets, cards.fallback(), cards.bucketedStreets(),
+                            quantized);
+}
+
+} // namespace pokerbots::skeleton
@@ -0,0 +1,65 @@
+#include "skeleton/endgame.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "skeleton/bounty.h"
+
+namespace pokerbots::skeleton {
+
+namespace {
+
+// the engine rounds a fractional bounty payout in favour of the player it pays
+constexpr int foldCost(int blind, bool hit) {
+  double cost = hit ? blind * BOUNTY_RATIO + BOUNTY_CONSTANT : blind;
+  return static_cast<int>(cost) + (cost > static_cast<int>(cost));
+}
+
+static_assert(foldCost(SMALL_BLIND, true) - foldCost(SMALL_BLIND, false) == FoldOutOdds::HIT_COST &&
+                  foldCost(BIG_BLIND, true) - foldCost(BIG_BLIND, false) == FoldOutOdds::HIT_COST,
+              "a hit bounty costs the same extra in either blind");
+
+} // namespace
+
+FoldOutOdds::FoldOutOdds(int rounds) : hitOdds(BOUNTY_ODDS(2, NUM_CARDS, NUM_SUITS)) {
+  // any rank is in two hole cards as often as a bounty rank is on a two-card board
+  atMost.resize(rounds + 1);
+  atMost[0] = {1.0};
+  for (int r = 1; r <= rounds; ++r) {
+    auto &row = atMost[r];
+    const auto &previous = atMost[r - 1];
+    row.resize(r + 1);
+    for (int k = 0; k <= r; ++k) {
+      double noHit = k < r ? previous[k] : 1.0;
+      double hit = k > 0 ? previous[k - 1] : 0.0;
+      row[k] = (1 - hitOdds) * noHit + hitOdds * hit;
+    }
+  }
+}
+
+int FoldOutOdds::blinds(int remaining, bool bigBlind) {
+  // the blinds alternate, starting with this round's
+  int ours = (remaining + bigBlind) / 2;
+  int theirs = remaining - ours;
+  return ours * foldCost(BIG_BLIND, false) + theirs * foldCost(SMALL_BLIND, false);
+}
+
+double FoldOutOdds::winProbability(int remaining, int bankroll, bool bigBlind) const {
+  remaining = std::clamp(remaining, 0, static_cast<int>(atMost.size()) - 1);
+  // ahead at the end as long as fewer than (bankroll - blinds) / HIT_COST bounties hit
+  int margin = bankroll - blinds(remaining, bigBlind);
+  if (margin <= 0) {
+    return 0;
+  }
+  int hits = (margin - 1) / HIT_COST;
+  return atMost[remaining][std::min(hits, remaining)];
+}
+
+int FoldOutOdds::lockInBankroll(int remaining, bool bigBlind, double confidence) const {
+  remaining = std::clamp(remaining, 0, static_cast<int>(atMost.size()) - 1);
+  const auto &row = atMost[remaining];
+  auto hits = static_cast<int>(std::lower_bound(row.begin(), row.end(), confidence) - row.begin());
+  return blinds(remaining, bigBlind) + HIT_COST * std::min(hits, remaining) + 1;
+}
+
+} // namespace pokerbots::skeleton
@@ -0,0 +1,198 @@
+#include "skeleton/equity.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace pokerbots::skeleton {
+
+namespace {
+
+struct Entry {
+  unsigned short value;
+  int combo;
+  float weight;
+};
+
+// Sweeps hero's combos against villain's, both sorted worst hand first, and adds
+// win + tie / 2 and the live villain weight per hero combo. Card removal is
+// handled by tracking how much villain weight sits on each card.
+void sweep(const std::vector<Entry> &hero, const std::vector<Entry> &villain,
+           const Range &villainRange, std::vector<double> &num, std::vector<double> &den) {
+  std::array<double, NUM_CARDS> cardTotal{};
+  double total = 0;
+  for (const auto &v : villain) {
+    total += v.weight;
+    cardTotal[COMBO_CARDS[v.combo].first] += v.weight;
+    cardTotal[COMBO_CARDS[v.combo].second] += v.weight;
+  }
+
+  std::array<double, NUM_CARDS> cardWorse{};
+  std::array<double, NUM_CARDS> cardNotBetter{};
+  double worse = 0;
+  double notBetter = 0;
+  std::size_t worseEnd = 0;
+  std::size_t notBetterEnd = 0;
+  for (const auto &h : hero) {
+    while (worseEnd < villain.size() && villain[worseEnd].value > h.value) {
+      const auto &v = villain[worseEnd++];
+      worse += v.weight;
+      cardWorse[COMBO_CARDS[v.combo].first] += v.weight;
+      cardWorse[COMBO_CARDS[v.combo].second] += v.weight;
+    }
+    while (notBetterEnd < villain.size() && villain[notBetterEnd].value >= h.value) {
+      const auto &v = villain[notBetterEnd++];
+      notBetter += v.weight;
+      cardNotBetter[COMBO_CARDS[v.combo].first] += v.weight;
+      cardNotBetter[COMBO_CARDS[v.combo].second] += v.weight;
+    }
+    auto [x, y] = COMBO_CARDS[h.combo];
+    // the identical combo ties with us and holds both our cards, so it was
+    // subtracted twice from the tie side and must be added back once
+    double same = villainRange[h.combo];
+    double win = worse - cardWorse[x] - cardWorse[y];
+    double tie = notBetter - cardNotBetter[x] - cardNotBetter[y] + same - win;
+    num[h.combo] += win + 0.5 * tie;
+    den[h.combo] += total - cardTotal[x] - cardTotal[y] + same;
+  }
+}
+
+std::int64_t choose(int n, int k) {
+  std::int64_t result = 1;
+  for (int i = 1; i <= k; ++i) {
+    result = result * (n - k + i) / i;
+  }
+  return result;
+}
+
+} // namespace
+
+RangeEquity computeRangeEquity(const std::vector<int> &board, const Range &rangeA,
+                               const Range &rangeB, bool withMatrix) {
+  RangeEquity result;
+
+  auto boardSet = CardSet::of(board);
+
+  std::array<int, NUM_COMBOS> rowOf;
+  std::array<int, NUM_COMBOS> columnOf;
+  rowOf.fill(-1);
+  columnOf.fill(-1);
+  for (int combo = 0; combo < NUM_COMBOS; ++combo) {
+    if (comboSet(combo).intersects(boardSet)) {
+      continue;
+    }
+    if (rangeA[combo] > 0) {
+      rowOf[combo] = static_cast<int>(result.combosA.size());
+      result.combosA.push_back(combo);
+    }
+    if (rangeB[combo] > 0) {
+      columnOf[combo] = static_cast<int>(result.combosB.size());
+      result.combosB.push_back(combo);
+    }
+  }
+  auto rows = result.combosA.size();
+  auto columns = result.combosB.size();
+  if (withMatrix) {
+    result.wins.assign(rows * columns, 0.0f);
+    result.ties.assign(rows * columns, 0.0f);
+  }
+
+  std::vector<int> deck(NUM_CARDS);
+  deck.resize((CardSet::deck() - boardSet).indices(deck.data()));
+
+  int toDeal = 5 - static_cast<int>(board.size());
+  std::vector<double> numA(NUM_COMBOS), denA(NUM_COMBOS), numB(NUM_COMBOS), denB(NUM_COMBOS);
+  std::vector<Entry> entriesA, entriesB;
+  entriesA.reserve(rows);
+  entriesB.reserve(columns);
+  std::array<unsigned short, NUM_COMBOS> values;
+
+  // odometer over the undealt cards, dealing toDeal of them in increasing order
+  std::vector<int> pick(toDeal);
+  for (int i = 0; i < toDeal; ++i) {
+    pick[i] = i;
+  }
+  while (true) {
+    int cards[7];
+    CardSet runout;
+    for (std::size_t i = 0; i < board.size(); ++i) {
+      cards[2 + i] = board[i];
+    }
+    for (int i = 0; i < toDeal; ++i) {
+      cards[2 + board.size() + i] = deck[pick[i]];
+      runout.add(deck[pick[i]]);
+    }
+
+    entriesA.clear();
+    entriesB.clear();
+    for (auto combo : result.combosA) {
+      if (comboSet(combo).intersects(runout)) {
+        continue;
+      }
+      cards[0] = COMBO_CARDS[combo].first;
+      cards[1] = COMBO_CARDS[combo].second;
+      values[combo] = evalIndices(cards, 7);
+      entriesA.push_back({values[combo], combo, rangeA[combo]});
+    }
+    for (auto combo : result.combosB) {
+      if (comboSet(combo).intersects(runout)) {
+        continue;
+      }
+      if (rowOf[combo] < 0) {
+        cards[0] = COMBO_CARDS[combo].first;
+        cards[1] = COMBO_CARDS[combo].second;
+        values[combo] = evalIndices(cards, 7);
+      }
+      entriesB.push_back({values[combo], combo, rangeB[combo]});
+    }
+
+    auto worstFirst = [](const Entry &a, const Entry &b) { return a.value > b.value; };
+    std::sort(entriesA.begin(), entriesA.end(), worstFirst);
+    std::sort(entriesB.begin(), entriesB.end(), worstFirst);
+    sweep(entriesA, entriesB, rangeB, numA, denA);
+    sweep(entriesB, entriesA, rangeA, numB, denB);
+
+    if (withMatrix) {
+      for (const auto &a : entriesA) {
+        auto mask = comboSet(a.combo);
+        auto row = static_cast<std::size_t>(rowOf[a.combo]) * columns;
+        for (const auto &b : entriesB) {
+          if (mask.intersects(comboSet(b.combo))) {
+            continue;
+          }
+          auto column = columnOf[b.combo];
+          result.wins[row + column] += a.value < b.value;
+          result.ties[row + column] += a.value == b.value;
+        }
+      }
+    }
+
+    // advance to the next runout
+    int i = toDeal - 1;
+    while (i >= 0 && pick[i] == static_cast<int>(deck.size()) - toDeal + i) {
+      --i;
+    }
+    if (i < 0) {
+      break;
+    }
+    ++pick[i];
+    for (int j = i + 1; j < toDeal; ++j) {
+      pick[j] = pick[j - 1] + 1;
+    }
+  }
+
+  for (int combo = 0; combo < NUM_COMBOS; ++combo) {
+    result.equityA[combo] = denA[combo] > 0 ? static_cast<float>(numA[combo] / denA[combo]) : 0.0f;
+    result.equityB[combo] = denB[combo] > 0 ? static_cast<float>(numB[combo] / denB[combo]) : 0.0f;
+  }
+  if (withMatrix) {
+    // every disjoint pair sees the same number of runouts
+    auto runouts = static_cast<float>(choose(static_cast<int>(deck.size()) - 4, toDeal));
+    for (std::size_t k = 0; k < result.wins.size(); ++k) {
+      result.wins[k] /= runouts;
+      result.ties[k] /= runouts;
+    }
+  }
+  return result;
+}
+
+} // namespace pokerbots::skeleton
@@ -0,0 +1,104 @@
+#include "skeleton/evaluator.h"
+
+#include <algorithm>
+
+#include "skeleton/arrays.h"
+
+namespace pokerbots::skeleton {
+
+namespace {
+
+inline unsigned fastHash(unsigned u) {
+  u += 0xe91aaa35;
+  u ^= (u >> 16);
+  u += (u << 8);
+  u ^= (u >> 4);
+  unsigned b = (u >> 8) & 0x1ff;
+  unsigned a = (u + (u << 2)) >> 19;
+  return a ^ hash_adjust[b];
+}
+
+const char RANK_CHARS[] = "23456789TJQKA";
+const char SUIT_CHARS[] = "cdhs";
+
+} // namespace
+
+int rankIndex(char rank) {
+  for (int r = 0; r < NUM_RANKS; ++r) {
+    if (RANK_CHARS[r] == rank) {
+      return r;
+    }
+  }
+  return -1;
+}
+
+int cardIndex(const std::string &card) {
+  if (card.size() < 2) {
+    return -1;
+  }
+  int rank = rankIndex(card[0]);
+  int suit = -1;
+  for (int s = 0; s < NUM_SUITS; ++s) {
+    if (SUIT_CHARS[s] == card[1]) {
+      suit = s;
+    }
+  }
+  return (rank < 0 || suit < 0) ? -1 : cardIndex(rank, suit);
+}
+
+std::string cardString(int card) {
+  return {RANK_CHARS[rankOf(card)], SUIT_CHARS[suitOf(card)]};
+}
+
+unsigned short eval5(CardCode c1, CardCode c2, CardCode c3, CardCode c4, CardCode c5) {
+  auto idx = (c1 | c2 | c3 | c4 | c5) >> 16;
+
+  // flushes[] only holds flushes and straight flushes
+  if (c1 & c2 & c3 & c4 & c5 & 0xF000) {
+    return flushes[idx];
+  }
+
+  // unique5[] covers straights and high cards
+  if (auto value = unique5[idx]) {
+    return value;
+  }
+
+  // everything with a paired rank goes through the prime-product perfect hash
+  auto product = (c1 & 0xFF) * (c2 & 0xFF) * (c3 & 0xFF) * (c4 & 0xFF) * (c5 & 0xFF);
+  return hash_values[fastHash(product)];
+}
+
+unsigned short eval7(const CardCode *cards, int n) {
+  if (n == 5) {
+    return eval5(cards[0], cards[1], cards[2], cards[3], cards[4]);
+  }
+  unsigned short best = 9999;
+  if (n == 6) {
+    // drop each card in turn
+    for (int skip = 0; skip < 6; ++skip) {
+      CardCode hand[5];
+      for (int i = 0, j = 0; i < 6; ++i) {
+        if (i != skip) {
+          hand[j++] = cards[i];
+        }
+      }
+      best = std::min(best, eval5(hand[0], hand[1], hand[2], hand[3], hand[4]));
+    }
+    return best;
+  }
+  for (const auto &perm : perm7) {
+    best = std::min(best, eval5(cards[perm[0]], cards[perm[1]], cards[perm[2]],
+                                cards[perm[3]], cards[perm[4]]));
+  }
+  return best;
+}
+
+unsigned short evalIndices(const int *cards, int n) {
+  CardCode codes[7];
+  for (int i = 0; i < n; ++i) {
+    codes[i] = CARD_CODES[cards[i]];
+  }
+  return eval7(codes, n);
+}
+
+} // namespace pokerbots::skeleton
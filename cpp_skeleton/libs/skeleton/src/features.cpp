@@ -0,0 +1,404 @@
+#include "skeleton/features.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "skeleton/buckets.h"
+#include "skeleton/card_set.h"
+#include "skeleton/constants.h"
+
+namespace pokerbots::skeleton {
+
+namespace {
+
+// situations a match revisits: a few per round, plus the boards speculation covers
+constexpr std::size_t SHARED_FEATURE_CAPACITY = 1 << 16;
+
+inline int standing(unsigned short ours, unsigned short theirs) {
+  // lower Cactus-Kev values are better hands
+  return ours < theirs ? FeatureCounts::AHEAD
+                       : (ours == theirs ? FeatureCounts::TIED : FeatureCounts::BEHIND);
+}
+
+inline double ratio(double num, double den) { return den > 0 ? num / den : 0; }
+
+// Sample mean of f over the samples and its standard error.
+template <typename Samples, typename F> Estimate meanOf(const Samples &samples, F f) {
+  Estimate estimate;
+  double n = static_cast<double>(samples.size());
+  if (n == 0) {
+    return estimate;
+  }
+  double sum = 0;
+  double squares = 0;
+  for (const auto &sample : samples) {
+    double x = f(sample);
+    sum += x;
+    squares += x * x;
+  }
+  estimate.mean = sum / n;
+  if (n > 1) {
+    estimate.standardError = std::sqrt(std::max(0.0, squares / n - estimate.mean * estimate.mean) / (n - 1));
+  }
+  return estimate;
+}
+
+// Index in [0, n) of a 32-bit fraction of the unit interval.
+inline int scaled(std::uint32_t fraction, int n) {
+  return static_cast<int>((static_cast<std::uint64_t>(fraction) * static_cast<std::uint32_t>(n)) >> 32);
+}
+
+/*
+  The first two dimensions of the Sobol sequence in 32-bit fixed point,
+  generated in Gray-code order and shifted by a random offset modulo one.
+  The shift makes every point uniform on its own while the points together
+  still cover the square far more evenly than independent ones.
+*/
+class SobolPair {
+public:
+  SobolPair() = default;
+
+  explicit SobolPair(Rng &rng) : shift{static_cast<std::uint32_t>(rng()), static_cast<std::uint32_t>(rng())} {}
+
+  std::array<std::uint32_t, 2> next() {
+    std::array<std::uint32_t, 2> point = {x[0] + shift[0], x[1] + shift[1]};
+    int bit = __builtin_ctz(++index);
+    // direction numbers: 1/2^(bit+1) in the first dimension, x + 1 as the primitive polynomial in the second
+    std::uint32_t direction = 1u << 31;
+    for (int b = 0; b < bit; ++b) {
+      direction ^= direction >> 1;
+    }
+    x[0] ^= 1u << (31 - bit);
+    x[1] ^= direction;
+    return point;
+  }
+
+private:
+  std::array<std::uint32_t, 2> shift{};
+  std::array<std::uint32_t, 2> x{};
+  std::uint32_t index = 0;
+};
+
+} // namespace
+
+void FeatureCounts::merge(const FeatureCounts &other) {
+  for (int now = 0; now < 3; ++now) {
+    for (int end = 0; end < 3; ++end) {
+      transitions[now][end] += other.transitions[now][end];
+    }
+  }
+  runouts += other.runouts;
+  squaredStrengthSum += other.squaredStrengthSum;
+  squaredRunouts += other.squaredRunouts;
+  bountyHits += other.bountyHits;
+  hitSamples += other.hitSamples;
+  hitStrength += other.hitStrength;
+}
+
+HandFeatures FeatureCounts::finish() const {
+  const auto &t = transitions;
+  std::array<double, 3> now{};
+  std::array<double, 3> end{};
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      now[i] += t[i][j];
+      end[j] += t[i][j];
+    }
+  }
+  double samples = now[AHEAD] + now[TIED] + now[BEHIND];
+
+  HandFeatures features;
+  features.equity = ratio(end[AHEAD] + end[TIED] / 2, samples);
+  features.notBehind = ratio(end[AHEAD] + end[TIED], samples);
+  features.handStrength = ratio(now[AHEAD] + now[TIED] / 2, samples);
+  features.ppot = ratio(t[BEHIND][AHEAD] + t[BEHIND][TIED] / 2 + t[TIED][AHEAD] / 2,
+                        now[BEHIND] + now[TIED] / 2);
+  features.npot = ratio(t[AHEAD][BEHIND] + t[AHEAD][TIED] / 2 + t[TIED][BEHIND] / 2,
+                        now[AHEAD] + now[TIED] / 2);
+  features.ehs = features.handStrength * (1 - features.npot) +
+                 (1 - features.handStrength) * features.ppot;
+  features.ehs2 = ratio(squaredStrengthSum, squaredRunouts);
+  features.bountyHit = ratio(bountyHits, runouts);
+  features.equityIfHit = ratio(hitStrength, hitSamples);
+  features.equityIfMiss = ratio(features.equity * samples - hitStrength, samples - hitSamples);
+  return features;
+}
+
+FeatureCounts sampleFeatures(const std::array<int, 2> &hole, const std::vector<int> &board,
+                             int bountyRank, int runouts, int opponentsPerRunout,
+                             Rng &rng, Sampling sampling) {
+  FeatureCounts counts;
+
+  auto dead = CardSet{hole[0], hole[1]} | CardSet::of(board);
+  // the live cards in a fixed order, which strata and Sobol points index
+  std::array<int, NUM_CARDS> order;
+  int deckSize = (CardSet::deck() - dead).indices(order.data());
+  auto deck = order;
+
+  int boardSize = static_cast<int>(board.size());
+  int toDeal = 5 - boardSize;
+
+  // cards[0..1] are the hand being scored, the board follows
+  int ours[7] = {hole[0], hole[1]};
+  int theirs[7];
+  for (int i = 0; i < boardSize; ++i) {
+    ours[2 + i] = board[i];
+    theirs[2 + i] = board[i];
+  }
+  auto oursNow = evalIndices(ours, 2 + boardSize);
+  bool bountyInHand = rankOf(hole[0]) == bountyRank || rankOf(hole[1]) == bountyRank;
+  for (int i = 0; i < boardSize; ++i) {
+    bountyInHand = bountyInHand || rankOf(board[i]) == bountyRank;
+  }
+
+  // partial Fisher-Yates: deck[0..position] holds the cards dealt so far in this sample
+  auto draw = [&](int position) {
+    std::swap(deck[position], deck[rng.between(position, deckSize - 1)]);
+    return deck[position];
+  };
+  // deals a chosen card at position instead, keeping the deck a permutation of the live cards
+  auto place = [&](int position, int card) {
+    std::swap(deck[position], *std::find(deck.begin() + position, deck.begin() + deckSize, card));
+  };
+
+  // only the chosen strategy draws its state, so RANDOM consumes the stream exactly as before
+  int stratum = sampling == Sampling::STRATIFIED ? static_cast<int>(rng.below(deckSize)) : 0;
+  auto sobol = sampling == Sampling::QUASI_RANDOM ? SobolPair(rng) : SobolPair();
+  std::array<int, NUM_CARDS> byRank;
+  std::array<int, NUM_CARDS> unseen;
+  if (sampling == Sampling::ANTITHETIC) {
+    byRank = order;
+    std::sort(byRank.begin(), byRank.begin() + deckSize, [](int a, int b) {
+      return rankOf(a) != rankOf(b) ? rankOf(a) < rankOf(b) : suitOf(a) < suitOf(b);
+    });
+  }
+
+  for (int r = 0; r < runouts; ++r) {
+    int dealt = 0;
+    if (sampling == Sampling::STRATIFIED && toDeal > 0) {
+      place(0, order[(stratum + r) % deckSize]);
+      dealt = 1;
+    } else if (sampling == Sampling::QUASI_RANDOM && toDeal > 0) {
+      auto point = sobol.next();
+      int first = scaled(point[0], deckSize);
+      place(0, order[first]);
+      dealt = 1;
+      if (toDeal > 1) {
+        int second = scaled(point[1], deckSize - 1);
+        place(1, order[second < first ? second : second + 1]);
+        dealt = 2;
+      }
+    }
+    for (int i = dealt; i < toDeal; ++i) {
+      draw(i);
+    }
+    bool bountyHit = bountyInHand;
+    for (int i = 0; i < toDeal; ++i) {
+      ours[2 + boardSize + i] = theirs[2 + boardSize + i] = deck[i];
+      bountyHit = bountyHit || rankOf(deck[i]) == bountyRank;
+    }
+    auto oursFinal = toDeal == 0 ? oursNow : evalIndices(ours, 7);
+
+    int unseenSize = 0;
+    if (sampling == Sampling::ANTITHETIC) {
+      auto runout = CardSet::of(deck.data(), toDeal);
+      for (int i = 0; i < deckSize; ++i) {
+        if (!runout.contains(byRank[i])) {
+          unseen[unseenSize++] = byRank[i];
+        }
+      }
+    }
+
+    // HS^2 needs independent draws: single opponents, or antithetic pairs averaged
+    bool paired = sampling == Sampling::ANTITHETIC;
+    double unit = 0;
+    int units = 0;
+    double strengthSum = 0;
+    double strengthSquares = 0;
+    int first = 0;
+    int second = 0;
+    for (int k = 0; k < opponentsPerRunout; ++k) {
+      if (!paired) {
+        theirs[0] = draw(toDeal);
+        theirs[1] = draw(toDeal + 1);
+      } else {
+        if (k % 2 == 0) {
+          first = static_cast<int>(rng.below(unseenSize));
+          second = static_cast<int>(rng.below(unseenSize - 1));
+          second += second >= first;
+        } else {
+          // the mirror image in rank order: uniform on its own, weak where the first was strong
+          first = unseenSize - 1 - first;
+          second = unseenSize - 1 - second;
+        }
+        theirs[0] = unseen[first];
+        theirs[1] = unseen[second];
+      }
+      auto theirsNow = evalIndices(theirs, 2 + boardSize);
+      auto theirsFinal = toDeal == 0 ? theirsNow : evalIndices(theirs, 7);
+      auto end = standing(oursFinal, theirsFinal);
+      counts.transitions[standing(oursNow, theirsNow)][end] += 1;
+      double strength = end == FeatureCounts::AHEAD ? 1.0 : (end == FeatureCounts::TIED ? 0.5 : 0.0);
+      counts.hitSamples += bountyHit;
+      counts.hitStrength += bountyHit ? strength : 0;
+      unit += strength;
+      if (!paired || k % 2 == 1) {
+        unit /= paired ? 2 : 1;
+        strengthSum += unit;
+        strengthSquares += unit * unit;
+        unit = 0;
+        units += 1;
+      }
+    }
+
+    counts.runouts += 1;
+    counts.bountyHits += bountyHit;
+    if (units > 1) {
+      // (sum^2 - sum of squares) / (k (k - 1)) is unbiased for HS_r^2
+      double k = units;
+      counts.squaredStrengthSum += (strengthSum * strengthSum - strengthSquares) / (k * (k - 1));
+      counts.squaredRunouts += 1;
+    }
+  }
+  return counts;
+}
+
+FeatureMemo::FeatureMemo(std::uint64_t seed, int runoutsPerBatch, int opponentsPerRunout, int maxBatches,
+                         ConcurrentCache<FeatureCounts> *shared, Sampling sampling)
+    : seed(seed), runoutsPerBatch(runoutsPerBatch), opponentsPerRunout(opponentsPerRunout),
+      maxBatches(maxBatches), shared(shared), sampling(sampling) {}
+
+const FeatureCounts &FeatureMemo::refine(const std::array<int, 2> &hole, const std::vector<int> &board,
+                                         int bountyRank) {
+  auto &e = entry(hole, board, bountyRank);
+  e.decisions = std::min(e.decisions + 1, maxBatches);
+  sample(e, hole, board, bountyRank, e.decisions);
+  return e.counts;
+}
+
+bool FeatureMemo::prepare(const std::array<int, 2> &hole, const std::vector<int> &board, int bountyRank) {
+  auto &e = entry(hole, board, bountyRank);
+  if (e.batches > 0) {
+    return false;
+  }
+  sample(e, hole, board, bountyRank, 1);
+  return true;
+}
+
+FeatureMemo::Entry &FeatureMemo::entry(const std::array<int, 2> &hole, const std::vector<int> &board,
+                                       int bountyRank) {
+  Key key{CardSet::of(hole).bits(), CardSet::of(board).bits(), bountyRank};
+  auto found = entries.find(key);
+  if (found != entries.end()) {
+    return found->second;
+  }
+  auto &e = entries[key];
+  e.rng = Rng(seed ^ KeyHash()(key));
+  if (shared) {
+    // the bounty rank is not a suit, so relabelling suits leaves every feature as it is
+    e.sharedKey = canonicalSituation(hole, board) << 4 | static_cast<std::uint64_t>(bountyRank + 1);
+    if (shared->find(e.sharedKey, e.counts)) {
+      e.batches = 1;
+    }
+  }
+  return e;
+}
+
+void FeatureMemo::sample(Entry &entry, const std::array<int, 2> &hole, const std::vector<int> &board,
+                         int bountyRank, int batches) {
+  if (entry.batches >= batches) {
+    return;
+  }
+  for (; entry.batches < batches; ++entry.batches) {
+    entry.counts.merge(sampleFeatures(hole, board, bountyRank, runoutsPerBatch, opponentsPerRunout, entry.rng, sampling));
+  }
+  if (shared) {
+    shared->insert(entry.sharedKey, entry.counts);
+  }
+}
+
+ConcurrentCache<FeatureCounts> &sharedFeatureCache() {
+  static ConcurrentCache<FeatureCounts> cache(SHARED_FEATURE_CAPACITY);
+  return cache;
+}
+
+ActionSamples::ActionSamples(const std::array<int, 2> &hole, const std::vector<int> &board, int bountyRank,
+                             int runouts, int opponentsPerRunout, Rng &rng) {
+  auto dead = CardSet{hole[0], hole[1]} | CardSet::of(board);
+  std::array<int, NUM_CARDS> deck;
+  int deckSize = (CardSet::deck() - dead).indices(deck.data());
+  auto draw = [&](int position) {
+    std::swap(deck[position], deck[rng.between(position, deckSize - 1)]);
+    return deck[position];
+  };
+
+  int boardSize = static_cast<int>(board.size());
+  int toDeal = 5 - boardSize;
+  int ours[7] = {hole[0], hole[1]};
+  int theirs[7];
+  for (int i = 0; i < boardSize; ++i) {
+    ours[2 + i] = theirs[2 + i] = board[i];
+  }
+  bountyNow = rankOf(hole[0]) == bountyRank || rankOf(hole[1]) == bountyRank;
+  for (auto card : board) {
+    bountyNow = bountyNow || rankOf(card) == bountyRank;
+  }
+
+  samples.reserve(static_cast<std::size_t>(runouts) * opponentsPerRunout);
+  for (int r = 0; r < runouts; ++r) {
+    bool bountyHit = bountyNow;
+    for (int i = 0; i < toDeal; ++i) {
+      ours[2 + boardSize + i] = theirs[2 + boardSize + i] = draw(i);
+      bountyHit = bountyHit || rankOf(deck[i]) == bountyRank;
+    }
+    auto oursFinal = evalIndices(ours, 7);
+    for (int k = 0; k < opponentsPerRunout; ++k) {
+      theirs[0] = draw(toDeal);
+      theirs[1] = draw(toDeal + 1);
+      auto theirsNow = evalIndices(theirs, 2 + boardSize);
+      auto theirsFinal = toDeal == 0 ? theirsNow : evalIndices(theirs, 7);
+      float showdown = oursFinal < theirsFinal ? 1.0f : (oursFinal == theirsFinal ? 0.5f : 0.0f);
+      samples.push_back({theirsNow, showdown, bountyHit});
+      sortedTheirsNow.push_back(theirsNow);
+    }
+  }
+  std::sort(sortedTheirsNow.begin(), sortedTheirsNow.end());
+}
+
+unsigned short ActionSamples::callingValue(double continuing) const {
+  // the weakest hand value that still calls; everything at least as strong calls too
+  auto calls = static_cast<std::size_t>(std::ceil(continuing * sortedTheirsNow.size()));
+  if (calls == 0) {
+    return 0;
+  }
+  return sortedTheirsNow[std::min(calls, sortedTheirsNow.size()) - 1];
+}
+
+double ActionSamples::payoff(const Sample &sample, const Candidate &candidate, unsigned short calling) const {
+  if (candidate.to > candidate.theirs && sample.theirsNow > calling) {
+    return bountyNow ? candidate.theirs * BOUNTY_RATIO + BOUNTY_CONSTANT : candidate.theirs;
+  }
+  double stake = std::max(candidate.to, candidate.theirs);
+  if (sample.showdown == 1.0f) {
+    return sample.bountyHit ? stake * BOUNTY_RATIO + BOUNTY_CONSTANT : stake;
+  }
+  if (sample.showdown == 0.5f) {
+    return sample.bountyHit ? stake * (BOUNTY_RATIO - 1) / 2 + BOUNTY_CONSTANT : 0.0;
+  }
+  return -stake;
+}
+
+Estimate ActionSamples::value(const Candidate &candidate) const {
+  auto calling = callingValue(candidate.continuing);
+  return meanOf(samples, [&](const Sample &sample) { return payoff(sample, candidate, calling); });
+}
+
+Estimate ActionSamples::difference(const Candidate &a, const Candidate &b) const {
+  auto callingA = callingValue(a.continuing);
+  auto callingB = callingValue(b.continuing);
+  return meanOf(samples,
+                [&](const Sample &sample) { return payoff(sample, a, callingA) - payoff(sample, b, callingB); });
+}
+
+} // namespace pokerbots::skeleton
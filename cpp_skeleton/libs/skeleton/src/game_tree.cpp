@@ -0,0 +1,194 @@
+#include "skeleton/game_tree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+#include "skeleton/action_history.h"
+
+namespace pokerbots::skeleton {
+
+GameTree::GameTree(BetAbstraction abstraction) : bets(std::move(abstraction)) {
+  // the cards never affect the betting, so the tree is built from an empty deal
+  std::array<std::array<std::string, 2>, 2> hands;
+  std::array<std::string, 5> deck;
+  auto start = std::make_shared<RoundState>(
+      0, 0, std::array<int, 2>{SMALL_BLIND, BIG_BLIND},
+      std::array<int, 2>{STARTING_STACK - SMALL_BLIND, STARTING_STACK - BIG_BLIND}, hands,
+      std::array<char, 2>{' ', ' '}, deck, nullptr);
+  nodes.emplace_back();
+  describe(root(), *start);
+  expand(root(), start, 0);
+}
+
+GameTree::GameTree(const RoundStatePtr &start, BetAbstraction abstraction, int lastStreet, int raisesThisStreet)
+    : bets(std::move(abstraction)), lastStreet(lastStreet) {
+  nodes.emplace_back();
+  describe(root(), *start);
+  expand(root(), start, raisesThisStreet);
+}
+
+void GameTree::describe(int index, const RoundState &state) {
+  auto &node = nodes[index];
+  node.player = static_cast<std::uint8_t>(getActive(state.button));
+  node.street = static_cast<std::uint8_t>(state.street);
+  node.pips = state.pips;
+  node.contributions = {STARTING_STACK - state.stacks[0], STARTING_STACK - state.stacks[1]};
+}
+
+void GameTree::expand(int index, const RoundStatePtr &state, int raisesThisStreet) {
+  auto active = getActive(state->button);
+  auto legal = state->legalActions();
+  auto continueCost = state->pips[1 - active] - state->pips[active];
+  std::vector<Action> actions;
+  if (continueCost > 0) {
+    actions.push_back({Action::Type::FOLD});
+    actions.push_back({Action::Type::CALL});
+  } else {
+    actions.push_back({Action::Type::CHECK});
+  }
+  if (legal.count(Action::Type::RAISE) && raisesThisStreet < bets.maxRaisesPerStreet) {
+    auto bounds = state->raiseBounds();
+    auto pot = nodes[index].contributions[0] + nodes[index].contributions[1];
+    std::vector<int> amounts;
+    for (auto fraction : bets.potFractions) {
+      auto amount = state->pips[1 - active] + static_cast<int>(std::lround(fraction * (pot + continueCost)));
+      amounts.push_back(std::clamp(amount, bounds[0], bounds[1]));
+    }
+    if (bets.allIn) {
+      amounts.push_back(bounds[1]);
+    }
+    std::sort(amounts.begin(), amounts.end());
+    amounts.erase(std::unique(amounts.begin(), amounts.end()), amounts.end());
+    for (auto amount : amounts) {
+      actions.push_back({Action::Type::RAISE, amount});
+    }
+  }
+
+  // lay out the whole block of children before descending into any of them
+  auto first = static_cast<int>(nodes.size());
+  nodes.resize(first + actions.size());
+  nodes[index].firstChild = static_cast<std::uint32_t>(first);
+  nodes[index].numActions = static_cast<std::uint8_t>(actions.size());
+  std::vector<std::pair<RoundStatePtr, int>> pending(actions.size());
+  for (std::size_t a = 0; a < actions.size(); ++a) {
+    auto child = first + static_cast<int>(a);
+    const auto &action = actions[a];
+    auto next = state->proceed(action);
+    if (action.actionType == Action::Type::FOLD) {
+      describe(child, *state);
+      nodes[child].kind = GameNode::FOLD;
+    } else if (auto terminal = std::dynamic_pointer_cast<const TerminalState>(next)) {
+      describe(child, static_cast<const RoundState &>(*terminal->previousState));
+      nodes[child].kind = GameNode::SHOWDOWN;
+      nodes[child].street = 5;
+    } else {
+      auto nextState = std::static_pointer_cast<const RoundState>(next);
+      describe(child, *nextState);
+      if (nextState->street > lastStreet) {
+        nodes[child].kind = GameNode::LEAF;
+      } else {
+        auto raises = nextState->street != state->street
+                          ? 0
+                          : raisesThisStreet + (action.actionType == Action::Type::RAISE);
+        pending[a] = {nextState, raises};
+      }
+    }
+    nodes[child].parent = static_cast<std::uint32_t>(index);
+    nodes[child].action = action;
+  }
+  for (std::size_t a = 0; a < actions.size(); ++a) {
+    if (pending[a].first) {
+      expand(first + static_cast<int>(a), pending[a].first, pending[a].second);
+    }
+  }
+}
+
+std::vector<std::uint8_t> GameTree::history(int index) const {
+  std::vector<std::uint8_t> path;
+  for (; index != root(); index = static_cast<int>(nodes[index].parent)) {
+    path.push_back(static_cast<std::uint8_t>(index - nodes[nodes[index].parent].firstChild));
+  }
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+int GameTree::follow(const std::vector<std::uint8_t> &history) const {
+  int index = root();
+  for (auto action : history) {
+    if (nodes[index].kind != GameNode::DECISION || action >= nodes[index].numActions) {
+      return -1;
+    }
+    index = child(index, action);
+  }
+  return index;
+}
+
+int GameTree::translate(int index, const Action &action) const {
+  const auto &node = nodes[index];
+  int best = -1;
+  int bestDistance = 0;
+  for (int a = 0; a < node.numActions; ++a) {
+    const auto &candidate = this->action(index, a);
+    if (candidate.actionType != Action::Type::RAISE || action.actionType != Action::Type::RAISE) {
+      // a check and a call both just close the action
+      auto passive = [](Action::Type t) { return t == Action::Type::CHECK || t == Action::Type::CALL; };
+      if (candidate.actionType == action.actionType ||
+          (passive(candidate.actionType) && passive(action.actionType))) {
+        return child(index, a);
+      }
+      continue;
+    }
+    auto distance = std::abs(candidate.amount - action.amount);
+    if (best < 0 || distance < bestDistance) {
+      best = child(index, a);
+      bestDistance = distance;
+    }
+  }
+  return best;
+}
+
+int GameTree::locate(const RoundState &state) const {
+  TreeCursor cursor(*this);
+  bool complete = forEachAction(state, [&](const RoundState &before, const RoundState *after, Action::Type type) {
+    cursor.step(before, after, type);
+  });
+  return complete ? cursor.index : -1;
+}
+
+void TreeCursor::reset() {
+  index = GameTree::root();
+  closedByCall = false;
+  last = nullptr;
+}
+
+bool TreeCursor::step(const RoundState &before, const RoundState *after, Action::Type type) {
+  if (index < 0) {
+    return false;
+  }
+  Action action{type};
+  if (type == Action::Type::RAISE) {
+    action.amount = after->pips[getActive(before.button)];
+  }
+  index = tree->translate(index, action);
+  if (index >= 0 && tree->node(index).kind != GameNode::DECISION) {
+    index = -1;
+  }
+  return index >= 0;
+}
+
+int TreeCursor::sync(const RoundStatePtr &state) {
+  auto visit = [&](const RoundState &before, const RoundState *after, Action::Type type) { step(before, after, type); };
+  if (!forEachActionSince(last.get(), *state, closedByCall, visit)) {
+    // not a continuation of what we followed, so replay the round from the root
+    reset();
+    if (!forEachActionSince(nullptr, *state, closedByCall, visit)) {
+      index = -1;
+    }
+  }
+  last = state;
+  return index;
+}
+
+} // namespace pokerbots::skeleton
@@ -0,0 +1,123 @@
+#include "skeleton/log.h"
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+
+namespace pokerbots::skeleton {
+
+namespace {
+
+// How long the flush thread sleeps when the queue is empty; producers never wake it.
+constexpr auto FLUSH_INTERVAL = std::chrono::milliseconds(2);
+
+} // namespace
+
+Logger::Logger(int fd, std::size_t budget) : fd(fd), budget(budget) {
+  for (std::size_t i = 0; i < NUM_SLOTS; ++i) {
+    slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  batch.reserve(64 * 1024);
+  flusher = std::thread([this]() { drain(); });
+}
+
+Logger::~Logger() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_one();
+  flusher.join();
+}
+
+void Logger::submit(const char *text, std::size_t length) {
+  auto size = length + 1;
+  if (used.fetch_add(size, std::memory_order_relaxed) + size > budget.load(std::memory_order_relaxed)) {
+    droppedLines.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  auto position = enqueuePosition.load(std::memory_order_relaxed);
+  Slot *slot;
+  while (true) {
+    slot = &slots[position % NUM_SLOTS];
+    auto sequence = slot->sequence.load(std::memory_order_acquire);
+    auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+    if (difference == 0) {
+      if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (difference < 0) {
+      // the flush thread is a full queue behind
+      droppedLines.fetch_add(1, std::memory_order_relaxed);
+      return;
+    } else {
+      position = enqueuePosition.load(std::memory_order_relaxed);
+    }
+  }
+  std::memcpy(slot->text, text, length);
+  slot->length = static_cast<std::uint32_t>(length);
+  slot->sequence.store(position + 1, std::memory_order_release);
+}
+
+void Logger::setBudget(std::size_t bytes) { budget.store(used.load() + bytes); }
+
+void Logger::flush() {
+  auto target = enqueuePosition.load();
+  std::unique_lock<std::mutex> lock(mutex);
+  wake.notify_one();
+  drained.wait(lock, [&]() { return written.load() >= target; });
+}
+
+void Logger::drain() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    lock.unlock();
+    bool wrote = writeBatch();
+    lock.lock();
+    drained.notify_all();
+    if (wrote) {
+      continue;
+    }
+    if (stopping) {
+      break;
+    }
+    wake.wait_for(lock, FLUSH_INTERVAL);
+  }
+}
+
+bool Logger::writeBatch() {
+  batch.clear();
+  while (true) {
+    auto &slot = slots[dequeuePosition % NUM_SLOTS];
+    if (slot.sequence.load(std::memory_order_acquire) != dequeuePosition + 1) {
+      break;
+    }
+    batch.append(slot.text, slot.length);
+    batch.push_back('\n');
+    slot.sequence.store(dequeuePosition + NUM_SLOTS, std::memory_order_release);
+    ++dequeuePosition;
+  }
+  const char *data = batch.data();
+  auto remaining = batch.size();
+  while (remaining > 0) {
+    auto count = ::write(fd, data, remaining);
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count <= 0) {
+      break;
+    }
+    data += count;
+    remaining -= count;
+  }
+  written.store(dequeuePosition);
+  return !batch.empty();
+}
+
+Logger &logger() {
+  static Logger instance;
+  return instance;
+}
+
+} // namespace pokerbots::skeleton
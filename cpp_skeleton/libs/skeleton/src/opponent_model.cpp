@@ -0,0 +1,274 @@
+#include "skeleton/opponent_model.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "skeleton/binary_io.h"
+#include "skeleton/buckets.h"
+
+namespace pokerbots::skeleton {
+
+namespace {
+
+struct EventPrior {
+  double mean;
+  double weight;   // in observations
+  double halfLife; // observations after which old evidence counts half
+};
+
+// Priors sit on the side of the thresholds the bot assumed before it had seen enough hands.
+constexpr std::array<EventPrior, OpponentModel::NUM_EVENTS> PRIORS = {{
+    {0.35, 15, 200}, // BET
+    {0.30, 8, 200},  // POT_BET
+    {0.08, 10, 200}, // RERAISE
+    {0.20, 20, 200}, // OPEN_RAISE
+    {0.10, 8, 200},  // BIG_OPEN_RAISE
+    {0.20, 15, 200}, // THREE_BET
+    {0.05, 2, 10},   // PASSIVE_ROUND, short memory so one real hand breaks a run
+}};
+
+constexpr std::uint32_t PROFILE_MAGIC = 0x4d4f4250; // "PBOM"
+constexpr std::uint32_t PROFILE_VERSION = 1;
+
+constexpr double FIT_DECAY = 0.993; // a half-life of about 100 bets and checks
+constexpr double MIN_FIT_POINTS = 8;
+constexpr double MIN_DEVIATION = 0.05;
+// never rule a combo out entirely, the fit is only a trend
+constexpr double MIN_LIKELIHOOD = 0.02;
+
+} // namespace
+
+OpponentModel::OpponentModel() {
+  for (int e = 0; e < NUM_EVENTS; ++e) {
+    decay[e] = std::exp2(-1.0 / PRIORS[e].halfLife);
+  }
+}
+
+void OpponentModel::observe(Event event, int street, int position, bool happened) {
+  overall[event].observe(happened, decay[event]);
+  runs[event] = happened ? runs[event] + 1 : 0;
+  cells[event][streetSlot(street)][position].observe(happened, decay[event]);
+}
+
+double OpponentModel::frequency(Event event) const {
+  return overall[event].mean(PRIORS[event].mean, PRIORS[event].weight);
+}
+
+double OpponentModel::frequency(Event event, int street, int position) const {
+  return cells[event][streetSlot(street)][position].mean(frequency(event), PRIORS[event].weight);
+}
+
+void OpponentModel::observeAction(const RoundState &before, const RoundState *after, Action::Type action,
+                                  int opponent) {
+  auto street = before.street;
+  auto continueCost = before.pips[1 - opponent] - before.pips[opponent];
+  bool raised = action == Action::Type::RAISE;
+  bool couldRaise = before.legalActions().count(Action::Type::RAISE) > 0;
+
+  if (street == 0) {
+    if (before.button == 0) {
+      observe(OPEN_RAISE, street, opponent, raised);
+      if (raised) {
+        observe(BIG_OPEN_RAISE, street, opponent, after->pips[opponent] > 12 && after->pips[opponent] <= 20);
+      }
+    } else if (continueCost > 0 && couldRaise) {
+      observe(THREE_BET, street, opponent, raised);
+    }
+    return;
+  }
+
+  if (continueCost == 0 && couldRaise) {
+    observe(BET, street, opponent, raised);
+  } else if (couldRaise) {
+    observe(RERAISE, street, opponent, raised);
+  }
+  if (raised) {
+    // measured as the price it offers us, as the bot saw it when facing the bet
+    auto toCall = after->pips[opponent] - after->pips[1 - opponent];
+    auto pot = 2 * STARTING_STACK - after->stacks[0] - after->stacks[1];
+    observe(POT_BET, street, opponent, static_cast<double>(toCall) / (pot - toCall) > 1.09);
+  }
+}
+
+void OpponentModel::observeRound(const TerminalState &terminal, int opponent) {
+  const RoundState *last = nullptr;
+  forEachAction(terminal, [&](const RoundState &before, const RoundState *after, Action::Type action) {
+    if (getActive(before.button) == opponent) {
+      observeAction(before, after, action, opponent);
+    }
+    last = after ? after : &before;
+  });
+  if (!last) {
+    return;
+  }
+  auto blind = opponent == 0 ? SMALL_BLIND : BIG_BLIND;
+  observe(PASSIVE_ROUND, last->street, opponent, STARTING_STACK - last->stacks[opponent] <= blind);
+}
+
+void StrengthFit::add(double size, double equity, double decay) {
+  weight = weight * decay + 1;
+  x = x * decay + size;
+  y = y * decay + equity;
+  xx = xx * decay + size * size;
+  xy = xy * decay + size * equity;
+  yy = yy * decay + equity * equity;
+}
+
+void OpponentModel::observeShowdown(const ShowdownRecord &record) {
+  for (int a = 0; a < record.numActions; ++a) {
+    const auto &action = record.actions[a];
+    if (action.player != record.opponent ||
+        (action.type != Action::Type::CHECK && action.type != Action::Type::RAISE)) {
+      continue;
+    }
+    auto slot = streetSlot(action.street);
+    strengthFits[slot].add(action.potFraction, record.equity[slot], FIT_DECAY);
+  }
+}
+
+std::optional<StrengthPrediction> OpponentModel::predictStrength(int street, double potFraction) const {
+  const auto &fit = strengthFits[streetSlot(street)];
+  if (fit.weight < MIN_FIT_POINTS) {
+    return std::nullopt;
+  }
+  auto meanX = fit.x / fit.weight;
+  auto meanY = fit.y / fit.weight;
+  auto varX = fit.xx / fit.weight - meanX * meanX;
+  auto covXY = fit.xy / fit.weight - meanX * meanY;
+  auto varY = fit.yy / fit.weight - meanY * meanY;
+  // with a single bet size seen the line is flat
+  auto slope = varX > 1e-6 ? covXY / varX : 0.0;
+  auto residual = varY - slope * covXY;
+  return StrengthPrediction{std::clamp(meanY + slope * (potFraction - meanX), 0.0, 1.0),
+                            std::sqrt(std::max(residual, MIN_DEVIATION * MIN_DEVIATION))};
+}
+
+bool OpponentModel::narrowRange(Range &range, const std::vector<int> &board, double potFraction) const {
+  auto street = static_cast<int>(board.size());
+  auto prediction = predictStrength(street, potFraction);
+  if ((street != 4 && street != 5) || !prediction) {
+    return false;
+  }
+  auto known = CardSet::of(board);
+  int cards[7];
+  std::copy(board.begin(), board.end(), cards + 2);
+
+  // equity against a random combo is the share of combos it beats on the river, averaged over rivers on the turn
+  std::vector<double> equity(NUM_COMBOS, 0.0);
+  std::vector<int> rivers(NUM_COMBOS, 0);
+  std::vector<std::pair<unsigned short, int>> values; // (hand value, combo)
+  values.reserve(NUM_COMBOS);
+  auto rank = [&](CardSet dead) {
+    values.clear();
+    for (int c = 0; c < NUM_COMBOS; ++c) {
+      const auto &combo = COMBO_CARDS[c];
+      if (range[c] > 0 && !comboSet(c).intersects(dead)) {
+        cards[0] = combo.first;
+        cards[1] = combo.second;
+        values.emplace_back(evalIndices(cards, 7), c);
+      }
+    }
+    if (values.size() < 2) {
+      return;
+    }
+    std::sort(values.begin(), values.end());
+    // ignoring card removal
+    auto others = static_cast<double>(values.size() - 1);
+    for (std::size_t lo = 0; lo < values.size();) {
+      auto hi = lo;
+      while (hi < values.size() && values[hi].first == values[lo].first) {
+        ++hi;
+      }
+      for (auto k = lo; k < hi; ++k) {
+        equity[values[k].second] += (values.size() - hi + 0.5 * (hi - lo - 1)) / others;
+        ++rivers[values[k].second];
+      }
+      lo = hi;
+    }
+  };
+  if (street == 5) {
+    rank(known);
+  } else {
+    for (int river : CardSet::deck() - known) {
+      cards[6] = river;
+      rank(known | CardSet{river});
+    }
+  }
+
+  bool changed = false;
+  for (int c = 0; c < NUM_COMBOS; ++c) {
+    if (rivers[c] > 0) {
+      auto z = (equity[c] / rivers[c] - prediction->mean) / prediction->deviation;
+      range[c] *= static_cast<float>(std::max(MIN_LIKELIHOOD, std::exp(-0.5 * z * z)));
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+bool OpponentModel::save(const std::string &path) const {
+  auto directory = std::filesystem::path(path).parent_path();
+  std::error_code error;
+  if (!directory.empty()) {
+    std::filesystem::create_directories(directory, error);
+  }
+  // per process, since both seats of a self-play match may save the same profile
+  auto temporary = path + "." + std::to_string(getpid()) + ".tmp";
+  {
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    writeValue(out, PROFILE_MAGIC);
+    writeValue(out, PROFILE_VERSION);
+    writeValue(out, static_cast<std::uint32_t>(NUM_EVENTS));
+    writeValue(out, overall);
+    writeValue(out, cells);
+    writeValue(out, strengthFits);
+    if (!out) {
+      return false;
+    }
+  }
+  return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+bool OpponentModel::load(const std::string &path, double carryOver) {
+  std::ifstream in(path, std::ios::binary);
+  std::uint32_t magic = 0;
+  std::uint32_t version = 0;
+  std::uint32_t events = 0;
+  OpponentModel stored;
+  if (!readValue(in, magic) || !readValue(in, version) || magic != PROFILE_MAGIC || version != PROFILE_VERSION ||
+      !readValue(in, events) || events != NUM_EVENTS || !readValue(in, stored.overall) ||
+      !readValue(in, stored.cells) || !readValue(in, stored.strengthFits)) {
+    return false;
+  }
+  auto scale = [carryOver](DecayedRate &rate) {
+    rate.hits *= carryOver;
+    rate.trials *= carryOver;
+  };
+  for (int e = 0; e < NUM_EVENTS; ++e) {
+    scale(stored.overall[e]);
+    for (auto &street : stored.cells[e]) {
+      for (auto &rate : street) {
+        scale(rate);
+      }
+    }
+  }
+  for (auto &fit : stored.strengthFits) {
+    for (auto sum : {&fit.weight, &fit.x, &fit.y, &fit.xx, &fit.xy, &fit.yy}) {
+      *sum *= carryOver;
+    }
+  }
+  overall = stored.overall;
+  cells = stored.cells;
+  strengthFits = stored.strengthFits;
+  return true;
+}
+
+} // namespace pokerbots::skeleton
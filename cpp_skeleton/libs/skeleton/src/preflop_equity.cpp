@@ -0,0 +1,148 @@
+#include "skeleton/preflop_equity.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include "skeleton/binary_io.h"
+
+namespace pokerbots::skeleton {
+
+namespace {
+
+constexpr std::uint32_t PREFLOP_MAGIC = 0x51455050; // "PPEQ"
+constexpr std::uint32_t PREFLOP_VERSION = 1;
+
+ComboPermutations makeComboPermutations() {
+  ComboPermutations permutations{};
+  std::array<int, NUM_SUITS> suits = {0, 1, 2, 3};
+  int p = 0;
+  do {
+    for (int combo = 0; combo < NUM_COMBOS; ++combo) {
+      auto [first, second] = COMBO_CARDS[combo];
+      permutations[p][combo] = static_cast<std::int16_t>(comboIndex(cardIndex(rankOf(first), suits[suitOf(first)]),
+                                                                    cardIndex(rankOf(second), suits[suitOf(second)])));
+    }
+    ++p;
+  } while (std::next_permutation(suits.begin(), suits.end()));
+  return permutations;
+}
+
+} // namespace
+
+const ComboPermutations &comboPermutations() {
+  static const ComboPermutations permutations = makeComboPermutations();
+  return permutations;
+}
+
+std::uint32_t canonicalMatchup(int a, int b, bool &swapped) {
+  auto best = ~0u;
+  for (const auto &permutation : comboPermutations()) {
+    auto pa = static_cast<std::uint32_t>(permutation[a]);
+    auto pb = static_cast<std::uint32_t>(permutation[b]);
+    if (pa * NUM_COMBOS + pb < best) {
+      best = pa * NUM_COMBOS + pb;
+      swapped = false;
+    }
+    if (pb * NUM_COMBOS + pa < best) {
+      best = pb * NUM_COMBOS + pa;
+      swapped = true;
+    }
+  }
+  return best;
+}
+
+bool PreflopEquity::load(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  std::uint32_t magic = 0;
+  std::uint32_t version = 0;
+  std::uint64_t classes = 0;
+  if (!readValue(in, magic) || !readValue(in, version) || magic != PREFLOP_MAGIC || version != PREFLOP_VERSION ||
+      !readValue(in, classes) || !readVector(in, keys, classes) || !readVector(in, counts, classes)) {
+    keys.clear();
+    counts.clear();
+    matrix.clear();
+    return false;
+  }
+  expand();
+  return true;
+}
+
+bool PreflopEquity::save(const std::string &path) const {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  writeValue(out, PREFLOP_MAGIC);
+  writeValue(out, PREFLOP_VERSION);
+  writeValue(out, static_cast<std::uint64_t>(keys.size()));
+  writeVector(out, keys);
+  writeVector(out, counts);
+  return static_cast<bool>(out);
+}
+
+void PreflopEquity::assign(std::vector<std::uint32_t> classKeys, std::vector<std::uint32_t> classCounts) {
+  keys = std::move(classKeys);
+  counts = std::move(classCounts);
+  expand();
+}
+
+void PreflopEquity::expand() {
+  // every matchup is a relabelling of its class's, from one side or the other; a partial table leaves the rest at 0
+  matrix.assign(static_cast<std::size_t>(NUM_COMBOS) * NUM_COMBOS, 0.0f);
+  for (std::size_t c = 0; c < keys.size(); ++c) {
+    float equity = counts[c] / (2.0f * PREFLOP_BOARDS);
+    for (const auto &permutation : comboPermutations()) {
+      std::size_t a = permutation[keys[c] / NUM_COMBOS];
+      std::size_t b = permutation[keys[c] % NUM_COMBOS];
+      matrix[a * NUM_COMBOS + b] = equity;
+      matrix[b * NUM_COMBOS + a] = 1 - equity;
+    }
+  }
+}
+
+double PreflopEquity::blockedWeight(int combo, const Range &range) {
+  auto [first, second] = COMBO_CARDS[combo];
+  double blocked = -range[combo]; // counted once with each of its cards
+  for (int card = 0; card < NUM_CARDS; ++card) {
+    if (card != first) {
+      blocked += range[comboIndex(first, card)];
+    }
+    if (card != second) {
+      blocked += range[comboIndex(second, card)];
+    }
+  }
+  return blocked;
+}
+
+double PreflopEquity::equity(int combo, const Range &range) const {
+  const float *row = &matrix[static_cast<std::size_t>(combo) * NUM_COMBOS];
+  double weighted = 0;
+  double total = 0;
+  for (int b = 0; b < NUM_COMBOS; ++b) {
+    weighted += row[b] * range[b];
+    total += range[b];
+  }
+  total -= blockedWeight(combo, range);
+  return total > 0 ? weighted / total : 0;
+}
+
+double PreflopEquity::equity(const Range &a, const Range &b) const {
+  double total = 0;
+  for (auto weight : b) {
+    total += weight;
+  }
+  double weighted = 0;
+  double pairs = 0;
+  for (int combo = 0; combo < NUM_COMBOS; ++combo) {
+    if (a[combo] <= 0) {
+      continue;
+    }
+    const float *row = &matrix[static_cast<std::size_t>(combo) * NUM_COMBOS];
+    double dot = 0;
+    for (int other = 0; other < NUM_COMBOS; ++other) {
+      dot += row[other] * b[other];
+    }
+    weighted += a[combo] * dot;
+    pairs += a[combo] * (total - blockedWeight(combo, b));
+  }
+  return pairs > 0 ? weighted / pairs : 0;
+}
+
+} // namespace pokerbots::skeleton
@@ -0,0 +1,39 @@
+#include "skeleton/random.h"
+
+#include <cstdlib>
+#include <random>
+#include <string>
+
+namespace pokerbots::skeleton {
+
+void Rng::jump() {
+  static constexpr std::uint64_t JUMP[] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL,
+                                           0x39abdc4529b1661cULL};
+  std::uint64_t jumped[4] = {0, 0, 0, 0};
+  for (auto word : JUMP) {
+    for (int bit = 0; bit < 64; ++bit) {
+      if (word & (1ULL << bit)) {
+        for (int i = 0; i < 4; ++i) {
+          jumped[i] ^= state[i];
+        }
+      }
+      (*this)();
+    }
+  }
+  for (int i = 0; i < 4; ++i) {
+    state[i] = jumped[i];
+  }
+}
+
+std::uint64_t masterSeed() {
+  static const std::uint64_t seed = []() {
+    if (const char *fixed = std::getenv("POKERBOT_SEED"); fixed && *fixed) {
+      return static_cast<std::uint64_t>(std::stoull(fixed));
+    }
+    std::random_device device;
+    return (static_cast<std::uint64_t>(device()) << 32) | device();
+  }();
+  return seed;
+}
+
+} // namespace pokerbots::skeleton
@@ -0,0 +1,401 @@
+#include "skeleton/resolver.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "skeleton/evaluator.h"
+
+namespace pokerbots::skeleton {
+
+namespace {
+
+constexpr double WIN_SHARE = BOUNTY_RATIO - 1;       // extra share of the pot won with a bounty
+constexpr double TIE_SHARE = (BOUNTY_RATIO - 1) / 2; // the same on a split pot
+
+// Local combos that fit one board, ordered for the showdown sweep.
+struct Showdown {
+  std::vector<int> board;
+  bool ready = false;                  // sorted on first use, so the turn does not pay for every river up front
+  std::vector<int> order;              // worst hand first
+  std::vector<std::uint16_t> strength; // hand value at each position of order
+  std::vector<HoleCards> cards;        // cards at each position of order
+  std::array<std::vector<float>, 2> hit;
+};
+
+class Subgame {
+public:
+  Subgame(const SubgameSpot &spot, const ResolveOptions &options, ThreadPool &pool);
+
+  void iterate(int iteration);
+
+  ResolveResult result() const;
+
+private:
+  using Vector = std::vector<double>;
+
+  void traverse(int index, int traverser, const Vector &reachSelf, const Vector &reachOpponent, double weight,
+                Vector &values);
+
+  void terminalValues(const GameNode &node, int traverser, const Vector &reachOpponent, Vector &values);
+
+  void showdownValues(const Showdown &board, int traverser, const Vector &reachOpponent, double contribution,
+                      double scale, double *values, Vector &scratch) const;
+
+  void bountyProbabilities(const std::vector<int> &board, std::array<std::vector<float>, 2> &hit) const;
+
+  void prepare(Showdown &showdown) const;
+
+  const SubgameSpot &spot;
+  ThreadPool &pool;
+  GameTree tree;
+  std::vector<HoleCards> combos;
+  std::array<Vector, 2> ranges;
+  std::array<std::vector<float>, 2> hitNow;
+  std::vector<Showdown> showdowns; // the river board, or one per river card on the turn
+  double runoutScale = 1.0;
+  std::size_t runoutsPerIteration;
+  std::size_t firstRunout = 0;
+  std::vector<std::size_t> offsets;
+  Vector regrets;
+  Vector averages;
+  std::vector<Vector> workerValues;
+  std::vector<Vector> workerScratch;
+  int heroLocal = -1;
+};
+
+Subgame::Subgame(const SubgameSpot &spot, const ResolveOptions &options, ThreadPool &pool)
+    : spot(spot), pool(pool),
+      tree(spot.state, options.bets, spot.state->street, 0) {
+  std::vector<int> board;
+  for (int i = 0; i < spot.state->street; ++i) {
+    board.push_back(cardIndex(spot.state->deck[i]));
+  }
+  auto dead = CardSet::of(board);
+
+  auto heroCombo = comboIndex(spot.heroHole[0], spot.heroHole[1]);
+  for (int c = 0; c < NUM_COMBOS; ++c) {
+    const auto &cards = COMBO_CARDS[c];
+    if (comboSet(c).intersects(dead)) {
+      continue;
+    }
+    if (c == heroCombo) {
+      heroLocal = static_cast<int>(combos.size());
+    }
+    combos.push_back(cards);
+    ranges[spot.hero].push_back(spot.heroRange[c]);
+    ranges[1 - spot.hero].push_back(spot.villainRange[c]);
+  }
+  // hero's own hand is always in its range, however small the estimate made it
+  ranges[spot.hero][heroLocal] = std::max(ranges[spot.hero][heroLocal], 1e-3);
+
+  bountyProbabilities(board, hitNow);
+
+  if (board.size() == 5) {
+    showdowns.emplace_back().board = board;
+    prepare(showdowns.back());
+  } else {
+    for (int card : CardSet::deck() - dead) {
+      showdowns.emplace_back().board = board;
+      showdowns.back().board.push_back(card);
+    }
+    // every pair of hands sees the same number of river cards
+    runoutScale = 1.0 / (NUM_CARDS - static_cast<int>(board.size()) - 4);
+  }
+
+  std::size_t total = 0;
+  for (int n = 0; n < tree.size(); ++n) {
+    offsets.push_back(total);
+    if (tree.node(n).kind == GameNode::DECISION) {
+      total += combos.size() * tree.node(n).numActions;
+    }
+  }
+  regrets.assign(total, 0.0);
+  averages.assign(total, 0.0);
+  workerValues.assign(pool.size(), Vector(combos.size()));
+  workerScratch.assign(pool.size(), Vector(2 * combos.size()));
+  runoutsPerIteration = std::clamp<std::size_t>(options.runoutsPerIteration, 1, showdowns.size());
+}
+
+void Subgame::prepare(Showdown &showdown) const {
+  std::vector<std::pair<int, int>> ranked;
+  int cards[7];
+  std::copy(showdown.board.begin(), showdown.board.end(), cards + 2);
+  auto river = showdown.board.back();
+  for (int h = 0; h < static_cast<int>(combos.size()); ++h) {
+    cards[0] = combos[h].first;
+    cards[1] = combos[h].second;
+    if (cards[0] == river || cards[1] == river) {
+      continue;
+    }
+    ranked.push_back({evalIndices(cards, 7), h});
+  }
+  std::sort(ranked.begin(), ranked.end(), std::greater<>());
+  for (const auto &[value, h] : ranked) {
+    showdown.order.push_back(h);
+    showdown.strength.push_back(static_cast<std::uint16_t>(value));
+    showdown.cards.push_back(combos[h]);
+  }
+  bountyProbabilities(showdown.board, showdown.hit);
+  showdown.ready = true;
+}
+
+void Subgame::bountyProbabilities(const std::vector<int> &board, std::array<std::vector<float>, 2> &hit) const {
+  unsigned boardRanks = 0;
+  for (auto card : board) {
+    boardRanks |= 1u << rankOf(card);
+  }
+  auto &hero = hit[spot.hero];
+  auto &villain = hit[1 - spot.hero];
+  hero.resize(combos.size());
+  villain.resize(combos.size());
+  for (std::size_t h = 0; h < combos.size(); ++h) {
+    auto ranks = boardRanks | 1u << rankOf(combos[h].first) | 1u << rankOf(combos[h].second);
+    hero[h] = spot.heroBountyRank >= 0 && (ranks >> spot.heroBountyRank) & 1 ? 1.0f : 0.0f;
+    // the opponent's bounty rank is uniform over the 13 ranks
+    villain[h] = __builtin_popcount(ranks) / static_cast<float>(NUM_RANKS);
+  }
+}
+
+void Subgame::showdownValues(const Showdown &board, int traverser, const Vector &reachOpponent,
+                             double contribution, double scale, double *values, Vector &scratch) const {
+  const auto &hitSelf = board.hit[traverser];
+  const auto &hitOpponent = board.hit[1 - traverser];
+  auto size = board.order.size();
+  // opponent reach (W) and reach times bounty probability (Q) in sweep order, then totals overall and per card
+  double *reachW = scratch.data();
+  double *reachQ = scratch.data() + size;
+  double totalW = 0;
+  double totalQ = 0;
+  double cardW[NUM_CARDS] = {};
+  double cardQ[NUM_CARDS] = {};
+  for (std::size_t i = 0; i < size; ++i) {
+    auto v = board.order[i];
+    reachW[i] = reachOpponent[v];
+    reachQ[i] = reachW[i] * hitOpponent[v];
+    totalW += reachW[i];
+    totalQ += reachQ[i];
+    cardW[board.cards[i].first] += reachW[i];
+    cardW[board.cards[i].second] += reachW[i];
+    cardQ[board.cards[i].first] += reachQ[i];
+    cardQ[board.cards[i].second] += reachQ[i];
+  }
+  if (totalW <= 0) {
+    return;
+  }
+
+  double weakerW = 0;
+  double weakerQ = 0;
+  double weakerCardW[NUM_CARDS] = {};
+  double weakerCardQ[NUM_CARDS] = {};
+  double tieCardW[NUM_CARDS] = {};
+  double tieCardQ[NUM_CARDS] = {};
+  for (std::size_t begin = 0; begin < size;) {
+    auto end = begin;
+    double tieW = 0;
+    double tieQ = 0;
+    for (; end < size && board.strength[end] == board.strength[begin]; ++end) {
+      tieW += reachW[end];
+      tieQ += reachQ[end];
+      tieCardW[board.cards[end].first] += reachW[end];
+      tieCardW[board.cards[end].second] += reachW[end];
+      tieCardQ[board.cards[end].first] += reachQ[end];
+      tieCardQ[board.cards[end].second] += reachQ[end];
+    }
+    for (auto i = begin; i < end; ++i) {
+      int a = board.cards[i].first;
+      int b = board.cards[i].second;
+      // hands sharing a card with ours are removed; ours is subtracted twice, so added back once
+      auto beatW = weakerW - weakerCardW[a] - weakerCardW[b];
+      auto beatQ = weakerQ - weakerCardQ[a] - weakerCardQ[b];
+      auto splitW = tieW - tieCardW[a] - tieCardW[b] + reachW[i];
+      auto splitQ = tieQ - tieCardQ[a] - tieCardQ[b] + reachQ[i];
+      auto loseW = totalW - cardW[a] - cardW[b] + reachW[i] - beatW - splitW;
+      auto loseQ = totalQ - cardQ[a] - cardQ[b] + reachQ[i] - beatQ - splitQ;
+      double p = hitSelf[board.order[i]];
+      auto win = contribution * (1 + WIN_SHARE * p) + BOUNTY_CONSTANT * p;
+      auto loss = contribution * loseW + (contribution * WIN_SHARE + BOUNTY_CONSTANT) * loseQ;
+      auto split = (contribution * TIE_SHARE + BOUNTY_CONSTANT) * (p * splitW - splitQ);
+      values[board.order[i]] += scale * (win * beatW - loss + split);
+    }
+    for (auto i = begin; i < end; ++i) {
+      weakerW += reachW[i];
+      weakerQ += reachQ[i];
+      weakerCardW[board.cards[i].first] += reachW[i];
+      weakerCardW[board.cards[i].second] += reachW[i];
+      weakerCardQ[board.cards[i].first] += reachQ[i];
+      weakerCardQ[board.cards[i].second] += reachQ[i];
+      tieCardW[board.cards[i].first] = tieCardW[board.cards[i].second] = 0;
+      tieCardQ[board.cards[i].first] = tieCardQ[board.cards[i].second] = 0;
+    }
+    begin = end;
+  }
+}
+
+void Subgame::terminalValues(const GameNode &node, int traverser, const Vector &reachOpponent, Vector &values) {
+  std::fill(values.begin(), values.end(), 0.0);
+  if (node.kind == GameNode::FOLD) {
+    double totalW = 0;
+    double totalQ = 0;
+    double cardW[NUM_CARDS] = {};
+    double cardQ[NUM_CARDS] = {};
+    const auto &hitOpponent = hitNow[1 - traverser];
+    for (std::size_t v = 0; v < combos.size(); ++v) {
+      auto w = reachOpponent[v];
+      auto q = w * hitOpponent[v];
+      totalW += w;
+      totalQ += q;
+      cardW[combos[v].first] += w;
+      cardW[combos[v].second] += w;
+      cardQ[combos[v].first] += q;
+      cardQ[combos[v].second] += q;
+    }
+    int folder = node.player;
+    double lost = node.contributions[folder];
+    for (std::size_t h = 0; h < combos.size(); ++h) {
+      int a = combos[h].first;
+      int b = combos[h].second;
+      auto w = totalW - cardW[a] - cardW[b] + reachOpponent[h];
+      auto q = totalQ - cardQ[a] - cardQ[b] + reachOpponent[h] * hitOpponent[h];
+      if (folder == traverser) {
+        values[h] = -(lost * w + (lost * WIN_SHARE + BOUNTY_CONSTANT) * q);
+      } else {
+        double p = hitNow[traverser][h];
+        values[h] = (lost * (1 + WIN_SHARE * p) + BOUNTY_CONSTANT * p) * w;
+      }
+    }
+    return;
+  }
+
+  double contribution = node.contributions[0];
+  if (showdowns.size() == 1) {
+    showdownValues(showdowns[0], traverser, reachOpponent, contribution, 1.0, values.data(), workerScratch[0]);
+    return;
+  }
+  for (auto &partial : workerValues) {
+    std::fill(partial.begin(), partial.end(), 0.0);
+  }
+  // this iteration's block of river cards stands in for all of them
+  auto scale = runoutScale * showdowns.size() / runoutsPerIteration;
+  pool.parallelFor(runoutsPerIteration, [&](std::size_t i, unsigned worker) {
+    auto &river = showdowns[(firstRunout + i) % showdowns.size()];
+    if (!river.ready) {
+      prepare(river);
+    }
+    showdownValues(river, traverser, reachOpponent, contribution, scale, workerValues[worker].data(),
+                   workerScratch[worker]);
+  });
+  for (const auto &partial : workerValues) {
+    for (std::size_t h = 0; h < values.size(); ++h) {
+      values[h] += partial[h];
+    }
+  }
+}
+
+void Subgame::traverse(int index, int traverser, const Vector &reachSelf, const Vector &reachOpponent,
+                       double weight, Vector &values) {
+  const auto &node = tree.node(index);
+  if (node.kind != GameNode::DECISION) {
+    terminalValues(node, traverser, reachOpponent, values);
+    return;
+  }
+
+  auto n = combos.size();
+  std::size_t actions = node.numActions;
+  double *regret = &regrets[offsets[index]];
+  Vector strategy(n * actions);
+  for (std::size_t h = 0; h < n; ++h) {
+    double total = 0;
+    for (std::size_t a = 0; a < actions; ++a) {
+      total += regret[h * actions + a];
+    }
+    for (std::size_t a = 0; a < actions; ++a) {
+      strategy[h * actions + a] = total > 0 ? regret[h * actions + a] / total : 1.0 / actions;
+    }
+  }
+
+  Vector child(n);
+  Vector nextReach(n);
+  std::fill(values.begin(), values.end(), 0.0);
+  if (node.player != traverser) {
+    for (std::size_t a = 0; a < actions; ++a) {
+      for (std::size_t h = 0; h < n; ++h) {
+        nextReach[h] = reachOpponent[h] * strategy[h * actions + a];
+      }
+      traverse(tree.child(index, static_cast<int>(a)), traverser, reachSelf, nextReach, weight, child);
+      for (std::size_t h = 0; h < n; ++h) {
+        values[h] += child[h];
+      }
+    }
+    return;
+  }
+
+  Vector actionValues(n * actions);
+  for (std::size_t a = 0; a < actions; ++a) {
+    for (std::size_t h = 0; h < n; ++h) {
+      nextReach[h] = reachSelf[h] * strategy[h * actions + a];
+    }
+    traverse(tree.child(index, static_cast<int>(a)), traverser, nextReach, reachOpponent, weight, child);
+    for (std::size_t h = 0; h < n; ++h) {
+      actionValues[h * actions + a] = child[h];
+      values[h] += strategy[h * actions + a] * child[h];
+    }
+  }
+  double *average = &averages[offsets[index]];
+  for (std::size_t h = 0; h < n; ++h) {
+    for (std::size_t a = 0; a < actions; ++a) {
+      auto i = h * actions + a;
+      // CFR+: regrets are floored at zero and the average is weighted by iteration
+      regret[i] = std::max(0.0, regret[i] + actionValues[i] - values[h]);
+      average[i] += weight * reachSelf[h] * strategy[i];
+    }
+  }
+}
+
+void Subgame::iterate(int iteration) {
+  Vector values(combos.size());
+  for (int traverser = 0; traverser < 2; ++traverser) {
+    traverse(GameTree::root(), traverser, ranges[traverser], ranges[1 - traverser], iteration, values);
+  }
+  firstRunout = (firstRunout + runoutsPerIteration) % showdowns.size();
+}
+
+ResolveResult Subgame::result() const {
+  ResolveResult result;
+  const auto &root = tree.node(GameTree::root());
+  if (root.kind != GameNode::DECISION || root.player != spot.hero) {
+    return result;
+  }
+  std::size_t actions = root.numActions;
+  for (std::size_t a = 0; a < actions; ++a) {
+    result.actions.push_back(tree.action(GameTree::root(), static_cast<int>(a)));
+  }
+  const double *average = &averages[offsets[GameTree::root()] + heroLocal * actions];
+  double total = 0;
+  for (std::size_t a = 0; a < actions; ++a) {
+    total += average[a];
+  }
+  for (std::size_t a = 0; a < actions; ++a) {
+    result.strategy.push_back(total > 0 ? average[a] / total : 1.0 / actions);
+  }
+  return result;
+}
+
+} // namespace
+
+ResolveResult resolveSubgame(const SubgameSpot &spot, ThreadPool &pool, const ResolveOptions &options) {
+  auto start = std::chrono::steady_clock::now();
+  Subgame game(spot, options, pool);
+  int iterations = 0;
+  while (iterations < options.maxIterations) {
+    game.iterate(++iterations);
+    if (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() >= options.seconds) {
+      break;
+    }
+  }
+  auto result = game.result();
+  result.iterations = iterations;
+  return result;
+}
+
+} // namespace pokerbots::skeleton
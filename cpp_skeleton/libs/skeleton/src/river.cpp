@@ -0,0 +1,114 @@
+#include "skeleton/river.h"
+
+#include <algorithm>
+
+#include "skeleton/card_set.h"
+
+namespace pokerbots::skeleton {
+
+namespace {
+
+// the board's three-card subsets
+constexpr int TRIPLES[10][3] = {{0, 1, 2}, {0, 1, 3}, {0, 1, 4}, {0, 2, 3}, {0, 2, 4},
+                                {0, 3, 4}, {1, 2, 3}, {1, 2, 4}, {1, 3, 4}, {2, 3, 4}};
+
+} // namespace
+
+RiverAnalysis::RiverAnalysis(const std::array<int, 2> &hole, const std::vector<int> &board) {
+  CardCode b[5];
+  for (int i = 0; i < 5; ++i) {
+    b[i] = CARD_CODES[board[i]];
+  }
+  auto boardOnly = eval5(b[0], b[1], b[2], b[3], b[4]);
+
+  // a flush needs three board cards of a suit, which at most one suit has; other suits do not matter
+  auto live = CardSet::deck() - CardSet::of(board);
+  int flushSuit = -1;
+  for (int suit = 0; suit < NUM_SUITS; ++suit) {
+    if ((live & CardSet(0x1FFFULL << (13 * suit))).size() <= 10) {
+      flushSuit = suit;
+    }
+  }
+  auto flushKey = [&](int card) { return rankOf(card) * 2 + (suitOf(card) == flushSuit); };
+
+  // best hand of each card with four of the board's
+  std::array<unsigned short, 2 * NUM_RANKS> byKey{};
+  std::array<unsigned short, NUM_CARDS> withOne;
+  for (int card : live) {
+    auto &best = byKey[flushKey(card)];
+    if (!best) {
+      best = boardOnly;
+      for (int skip = 0; skip < 5; ++skip) {
+        CardCode four[4];
+        for (int i = 0, j = 0; i < 5; ++i) {
+          if (i != skip) {
+            four[j++] = b[i];
+          }
+        }
+        best = std::min(best, eval5(CARD_CODES[card], four[0], four[1], four[2], four[3]));
+      }
+    }
+    withOne[card] = best;
+  }
+
+  // and a combo's value depends only on its ranks and on which of its cards are of that suit
+  std::array<unsigned short, 4 * NUM_RANKS * NUM_RANKS> memo{};
+  auto evaluate = [&](int first, int second) {
+    auto key = flushKey(first) * 2 * NUM_RANKS + flushKey(second);
+    if (memo[key]) {
+      return memo[key];
+    }
+    auto best = std::min(withOne[first], withOne[second]);
+    auto c1 = CARD_CODES[first];
+    auto c2 = CARD_CODES[second];
+    for (const auto &triple : TRIPLES) {
+      best = std::min(best, eval5(c1, c2, b[triple[0]], b[triple[1]], b[triple[2]]));
+    }
+    return memo[key] = best;
+  };
+
+  ours = evaluate(hole[0], hole[1]);
+  live -= CardSet{hole[0], hole[1]};
+  values.reserve(static_cast<std::size_t>(live.size()) * (live.size() - 1) / 2);
+  for (int first : live) {
+    for (int second : live - CardSet(~0ULL >> (63 - first))) {
+      auto value = evaluate(first, second);
+      // lower values are better hands
+      better += value < ours;
+      tied += value == ours;
+      values.emplace_back(comboIndex(first, second), value);
+    }
+  }
+}
+
+double RiverAnalysis::percentile() const {
+  if (values.empty()) {
+    return 0;
+  }
+  return (combos() - better - tied + tied / 2.0) / combos();
+}
+
+double RiverAnalysis::notBehind() const {
+  if (values.empty()) {
+    return 0;
+  }
+  return static_cast<double>(combos() - better) / combos();
+}
+
+RiverAnalysis::Share RiverAnalysis::against(const Range &range) const {
+  Share share;
+  double total = 0;
+  for (const auto &[combo, value] : values) {
+    auto weight = range[combo];
+    total += weight;
+    share.win += value > ours ? weight : 0;
+    share.tie += value == ours ? weight : 0;
+  }
+  if (total > 0) {
+    share.win /= total;
+    share.tie /= total;
+  }
+  return share;
+}
+
+} // namespace pokerbots::skeleton
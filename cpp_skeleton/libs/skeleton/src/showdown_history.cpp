@@ -0,0 +1,115 @@
+#include "skeleton/showdown_history.h"
+
+#include <utility>
+
+#include "skeleton/card_set.h"
+#include "skeleton/evaluator.h"
+
+namespace pokerbots::skeleton {
+
+namespace {
+
+constexpr int EQUITY_SAMPLES = 256;
+
+// Showdown equity of hole on the first boardSize cards of board against a random hand:
+// exact on the river, sampled over runouts and opponent hands before it.
+double equityVsRandom(const std::array<int, 2> &hole, const std::array<int, 5> &board, int boardSize,
+                      Rng &rng) {
+  auto dead = CardSet{hole[0], hole[1]} | CardSet::of(board.data(), boardSize);
+  int ours[7] = {hole[0], hole[1]};
+  int theirs[7];
+  for (int i = 0; i < boardSize; ++i) {
+    ours[2 + i] = theirs[2 + i] = board[i];
+  }
+  std::array<int, NUM_CARDS> deck;
+  int deckSize = (CardSet::deck() - dead).indices(deck.data());
+
+  double score = 0;
+  double samples = 0;
+  if (boardSize == 5) {
+    auto value = evalIndices(ours, 7);
+    for (int i = 0; i < deckSize; ++i) {
+      for (int j = i + 1; j < deckSize; ++j) {
+        theirs[0] = deck[i];
+        theirs[1] = deck[j];
+        auto other = evalIndices(theirs, 7);
+        score += value < other ? 1.0 : (value == other ? 0.5 : 0.0);
+        samples += 1;
+      }
+    }
+    return score / samples;
+  }
+
+  int toDeal = 5 - boardSize;
+  for (int s = 0; s < EQUITY_SAMPLES; ++s) {
+    for (int i = 0; i < toDeal + 2; ++i) {
+      std::swap(deck[i], deck[rng.between(i, deckSize - 1)]);
+    }
+    for (int i = 0; i < toDeal; ++i) {
+      ours[2 + boardSize + i] = theirs[2 + boardSize + i] = deck[i];
+    }
+    theirs[0] = deck[toDeal];
+    theirs[1] = deck[toDeal + 1];
+    auto value = evalIndices(ours, 7);
+    auto other = evalIndices(theirs, 7);
+    score += value < other ? 1.0 : (value == other ? 0.5 : 0.0);
+  }
+  return score / EQUITY_SAMPLES;
+}
+
+} // namespace
+
+ShowdownHistory::ShowdownHistory(int capacity, unsigned seed) : records(capacity), rng(seed) {}
+
+bool ShowdownHistory::record(const TerminalState &terminal, int active, int round) {
+  auto last = dynamic_cast<const RoundState *>(terminal.previousState.get());
+  if (!last) {
+    return false;
+  }
+  auto opponent = 1 - active;
+  std::array<int, 2> hole = {cardIndex(last->hands[opponent][0]), cardIndex(last->hands[opponent][1])};
+  std::array<int, 5> board;
+  for (int i = 0; i < 5; ++i) {
+    board[i] = cardIndex(last->deck[i]);
+  }
+  if (hole[0] < 0 || hole[1] < 0 || board[4] < 0) {
+    return false;
+  }
+
+  auto slot = static_cast<int>((first + count) % records.size());
+  if (count < static_cast<int>(records.size())) {
+    ++count;
+  } else {
+    first = (first + 1) % static_cast<int>(records.size());
+  }
+  auto &r = records[slot];
+  r.round = round;
+  r.opponent = static_cast<std::uint8_t>(opponent);
+  r.hole = {static_cast<std::int8_t>(hole[0]), static_cast<std::int8_t>(hole[1])};
+  for (int i = 0; i < 5; ++i) {
+    r.board[i] = static_cast<std::int8_t>(board[i]);
+  }
+  constexpr int BOARD_SIZES[4] = {0, 3, 4, 5};
+  for (int s = 0; s < 4; ++s) {
+    r.equity[s] = static_cast<float>(equityVsRandom(hole, board, BOARD_SIZES[s], rng));
+  }
+
+  r.numActions = 0;
+  forEachAction(terminal, [&](const RoundState &before, const RoundState *after, Action::Type type) {
+    if (r.numActions == MAX_SHOWDOWN_ACTIONS) {
+      return;
+    }
+    auto actor = getActive(before.button);
+    float potFraction = 0;
+    if (type == Action::Type::RAISE) {
+      auto toCall = after->pips[actor] - after->pips[1 - actor];
+      auto pot = 2 * STARTING_STACK - after->stacks[0] - after->stacks[1];
+      potFraction = static_cast<float>(toCall) / (pot - toCall);
+    }
+    r.actions[r.numActions++] = {static_cast<std::uint8_t>(before.street), static_cast<std::uint8_t>(actor), type,
+                                 potFraction};
+  });
+  return true;
+}
+
+} // namespace pokerbots::skeleton
@@ -0,0 +1,165 @@
+#include "skeleton/strategy_table.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include "skeleton/binary_io.h"
+#include "skeleton/buckets.h"
+
+namespace pokerbots::skeleton {
+
+namespace {
+
+constexpr std::uint32_t STRATEGY_MAGIC = 0x51534250; // "PBSQ"
+constexpr std::uint32_t STRATEGY_VERSION = 2;
+constexpr std::uint32_t MAX_FRACTIONS = 64;
+
+// Reads header fields straight out of the mapping.
+struct Cursor {
+  const std::uint8_t *position;
+  const std::uint8_t *end;
+
+  template <typename T> bool read(T &value) {
+    if (end - position < static_cast<std::ptrdiff_t>(sizeof(T))) {
+      return false;
+    }
+    std::memcpy(&value, position, sizeof(T));
+    position += sizeof(T);
+    return true;
+  }
+};
+
+} // namespace
+
+InfoSetLayout::InfoSetLayout(const GameTree &tree, std::array<int, 4> buckets) : buckets(buckets) {
+  offsets.resize(tree.size());
+  width.resize(tree.size());
+  for (int n = 0; n < tree.size(); ++n) {
+    const auto &node = tree.node(n);
+    offsets[n] = total;
+    if (node.kind == GameNode::DECISION) {
+      width[n] = node.numActions;
+      total += 2 * static_cast<std::size_t>(buckets[streetSlot(node.street)]) * width[n];
+    }
+  }
+}
+
+void quantizeStrategy(const double *probabilities, int actions, std::uint8_t *out) {
+  // largest remainder rounding, so the bytes always sum to QUANTIZED_TOTAL
+  std::vector<double> remainders(actions);
+  int assigned = 0;
+  for (int a = 0; a < actions; ++a) {
+    auto scaled = probabilities[a] * QUANTIZED_TOTAL;
+    out[a] = static_cast<std::uint8_t>(scaled);
+    remainders[a] = scaled - out[a];
+    assigned += out[a];
+  }
+  for (; assigned < QUANTIZED_TOTAL; ++assigned) {
+    auto largest = std::max_element(remainders.begin(), remainders.end()) - remainders.begin();
+    ++out[largest];
+    remainders[largest] = -1;
+  }
+}
+
+bool writeStrategyTable(const std::string &path, const BetAbstraction &bets, const std::array<int, 4> &buckets,
+                        int fallbackBuckets, std::uint8_t bucketedStreets, const std::vector<std::uint8_t> &quantized) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  writeValue(out, STRATEGY_MAGIC);
+  writeValue(out, STRATEGY_VERSION);
+  writeValue(out, static_cast<std::uint32_t>(bets.potFractions.size()));
+  writeVector(out, bets.potFractions);
+  writeValue(out, static_cast<std::uint8_t>(bets.allIn));
+  writeValue(out, static_cast<std::int32_t>(bets.maxRaisesPerStreet));
+  for (auto count : buckets) {
+    writeValue(out, static_cast<std::int32_t>(count));
+  }
+  writeValue(out, static_cast<std::int32_t>(fallbackBuckets));
+  writeValue(out, bucketedStreets);
+  writeValue(out, static_cast<std::uint64_t>(quantized.size()));
+  writeVector(out, quantized);
+  return static_cast<bool>(out);
+}
+
+StrategyTable::~StrategyTable() { unmap(); }
+
+void StrategyTable::unmap() {
+  if (mapping) {
+    munmap(mapping, mappingSize);
+  }
+  mapping = nullptr;
+  mappingSize = 0;
+  probabilities = nullptr;
+}
+
+bool StrategyTable::load(const std::string &path) {
+  unmap();
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size == 0) {
+    close(fd);
+    return false;
+  }
+  mappingSize = static_cast<std::size_t>(info.st_size);
+  mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    mapping = nullptr;
+    return false;
+  }
+  // lookups jump all over the table, so read-ahead would only waste startup time
+  madvise(mapping, mappingSize, MADV_RANDOM);
+
+  auto begin = static_cast<const std::uint8_t *>(mapping);
+  Cursor cursor{begin, begin + mappingSize};
+  std::uint32_t magic = 0;
+  std::uint32_t version = 0;
+  std::uint32_t fractions = 0;
+  std::uint8_t allIn = 0;
+  std::int32_t maxRaises = 0;
+  std::array<std::int32_t, 4> bucketCounts{};
+  std::int32_t fallbackBuckets = 0;
+  std::uint8_t bucketedStreets = 0;
+  std::uint64_t total = 0;
+  BetAbstraction bets;
+  if (!cursor.read(magic) || !cursor.read(version) || magic != STRATEGY_MAGIC ||
+      version != STRATEGY_VERSION || !cursor.read(fractions) || fractions > MAX_FRACTIONS) {
+    unmap();
+    return false;
+  }
+  bets.potFractions.resize(fractions);
+  for (auto &fraction : bets.potFractions) {
+    cursor.read(fraction);
+  }
+  if (!cursor.read(allIn) || !cursor.read(maxRaises) || !cursor.read(bucketCounts) || !cursor.read(fallbackBuckets) ||
+      !cursor.read(bucketedStreets) || !cursor.read(total) ||
+      static_cast<std::uint64_t>(cursor.end - cursor.position) != total) {
+    unmap();
+    return false;
+  }
+  bets.allIn = allIn != 0;
+  bets.maxRaisesPerStreet = maxRaises;
+
+  auto tree = std::make_unique<GameTree>(bets);
+  auto infoSets = std::make_unique<InfoSetLayout>(*tree, bucketCounts);
+  if (infoSets->size() != total) {
+    unmap();
+    return false;
+  }
+  gameTree = std::move(tree);
+  layout = std::move(infoSets);
+  probabilities = cursor.position;
+  fallback = fallbackBuckets;
+  bucketed = bucketedStreets;
+  return true;
+}
+
+} // namespace pokerbots::skeleton
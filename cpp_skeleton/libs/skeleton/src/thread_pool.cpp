@@ -0,0 +1,62 @@
+#include "skeleton/thread_pool.h"
+
+#include <algorithm>
+
+namespace pokerbots::skeleton {
+
+ThreadPool::ThreadPool(unsigned threads) {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  for (unsigned w = 0; w < threads; ++w) {
+    workers.emplace_back([this, w] { work(w); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  jobReady.notify_all();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+}
+
+void ThreadPool::submit(std::function<void(unsigned)> job) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    jobs.push_back(std::move(job));
+  }
+  jobReady.notify_one();
+}
+
+void ThreadPool::wait() {
+  std::unique_lock<std::mutex> lock(mutex);
+  jobsDone.wait(lock, [this] { return jobs.empty() && running == 0; });
+}
+
+void ThreadPool::work(unsigned worker) {
+  while (true) {
+    std::function<void(unsigned)> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      jobReady.wait(lock, [this] { return stopping || !jobs.empty(); });
+      if (stopping && jobs.empty()) {
+        return;
+      }
+      job = std::move(jobs.front());
+      jobs.pop_front();
+      ++running;
+    }
+    job(worker);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      --running;
+    }
+    jobsDone.notify_all();
+  }
+}
+
+} // namespace pokerbots::skeleton
@@ -0,0 +1,73 @@
+#include "skeleton/transcript.h"
+
+#include <filesystem>
+
+#include "skeleton/binary_io.h"
+
+namespace pokerbots::skeleton {
+
+namespace {
+
+constexpr std::uint32_t TRANSCRIPT_MAGIC = 0x52544250; // "PBTR"
+constexpr std::uint32_t TRANSCRIPT_VERSION = 1;
+
+// a packet is a few hundred bytes at most, anything longer is a corrupt length
+constexpr std::uint32_t MAX_LINE = 1 << 16;
+
+} // namespace
+
+bool TranscriptWriter::open(const std::string &path) {
+  auto directory = std::filesystem::path(path).parent_path();
+  std::error_code error;
+  if (!directory.empty()) {
+    std::filesystem::create_directories(directory, error);
+  }
+  out.open(path, std::ios::binary | std::ios::trunc);
+  writeValue(out, TRANSCRIPT_MAGIC);
+  writeValue(out, TRANSCRIPT_VERSION);
+  start = std::chrono::steady_clock::now();
+  if (!out) {
+    out.close();
+    return false;
+  }
+  return true;
+}
+
+void TranscriptWriter::write(TranscriptEntry::Direction direction, const std::string &line) {
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  writeValue(out, direction);
+  writeValue(out, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+  writeValue(out, static_cast<std::uint32_t>(line.size()));
+  out.write(line.data(), line.size());
+}
+
+void TranscriptWriter::close() {
+  if (out.is_open()) {
+    out.close();
+  }
+}
+
+bool readTranscript(const std::string &path, std::vector<TranscriptEntry> &entries) {
+  std::ifstream in(path, std::ios::binary);
+  std::uint32_t magic = 0;
+  std::uint32_t version = 0;
+  if (!readValue(in, magic) || !readValue(in, version) || magic != TRANSCRIPT_MAGIC ||
+      version != TRANSCRIPT_VERSION) {
+    return false;
+  }
+  entries.clear();
+  TranscriptEntry entry;
+  std::uint32_t size = 0;
+  // a match cut off mid-write leaves a partial last entry, which is dropped
+  while (readValue(in, entry.direction) && readValue(in, entry.nanoseconds) && readValue(in, size) &&
+         size <= MAX_LINE) {
+    entry.line.resize(size);
+    if (!in.read(entry.line.data(), size)) {
+      break;
+    }
+    entries.push_back(entry);
+  }
+  return true;
+}
+
+} // namespace pokerbots::skeleton
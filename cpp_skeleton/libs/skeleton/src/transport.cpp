@@ -0,0 +1,347 @@
+#include "skeleton/transport.h"
+
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/connect.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+
+namespace pokerbots::skeleton {
+
+namespace {
+
+// Yields before a waiting reader or writer goes to sleep; long enough to cover a quick reply.
+constexpr int SPINS = 2000;
+
+/*
+  Byte queue between one writing and one reading thread. The indices only
+  grow; a position is index & mask. Waiting is a spin, then a condition
+  variable that the other side only touches when someone sleeps on it.
+*/
+class ByteRing {
+public:
+  explicit ByteRing(std::size_t capacity) {
+    std::size_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    buffer.resize(size);
+    mask = size - 1;
+  }
+
+  // Blocks until all of data is queued or the ring is closed, returns how much was queued.
+  std::size_t write(const char *data, std::size_t size) {
+    std::size_t written = 0;
+    while (written < size) {
+      auto end = tail.load(std::memory_order_relaxed);
+      std::size_t space = 0;
+      if (!await([&]() { return (space = buffer.size() - (end - head.load())) > 0; })) {
+        break;
+      }
+      auto chunk = std::min(space, size - written);
+      copyIn(end, data + written, chunk);
+      tail.store(end + chunk);
+      wake();
+      written += chunk;
+    }
+    return written;
+  }
+
+  // Blocks until something can be read, returns 0 only once the ring is closed and drained.
+  std::size_t read(char *data, std::size_t size) {
+    auto start = head.load(std::memory_order_relaxed);
+    std::size_t available = 0;
+    if (!await([&]() { return (available = tail.load() - start) > 0; })) {
+      return 0;
+    }
+    auto chunk = std::min(available, size);
+    copyOut(start, data, chunk);
+    head.store(start + chunk);
+    wake();
+    return chunk;
+  }
+
+  void close() {
+    closed.store(true);
+    std::lock_guard<std::mutex> lock(mutex);
+    condition.notify_all();
+  }
+
+private:
+  void copyIn(std::size_t at, const char *data, std::size_t size) {
+    auto offset = at & mask;
+    auto first = std::min(size, buffer.size() - offset);
+    std::memcpy(buffer.data() + offset, data, first);
+    std::memcpy(buffer.data(), data + first, size - first);
+  }
+
+  void copyOut(std::size_t at, char *data, std::size_t size) const {
+    auto offset = at & mask;
+    auto first = std::min(size, buffer.size() - offset);
+    std::memcpy(data, buffer.data() + offset, first);
+    std::memcpy(data + first, buffer.data(), size - first);
+  }
+
+  // Waits until ready() holds or the ring is closed, returns ready().
+  template <typename Ready> bool await(Ready ready) {
+    for (int spin = 0; spin < SPINS; ++spin) {
+      if (ready()) {
+        return true;
+      }
+      if (closed.load()) {
+        return ready();
+      }
+      std::this_thread::yield();
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    sleepers.fetch_add(1);
+    condition.wait(lock, [&]() { return ready() || closed.load(); });
+    sleepers.fetch_sub(1);
+    return ready();
+  }
+
+  void wake() {
+    // the index store above is sequentially consistent, so a sleeper either sees it or is counted here
+    if (sleepers.load() > 0) {
+      std::lock_guard<std::mutex> lock(mutex);
+      condition.notify_all();
+    }
+  }
+
+  std::vector<char> buffer;
+  std::size_t mask = 0;
+  std::atomic<std::size_t> head{0};
+  std::atomic<std::size_t> tail{0};
+  std::atomic<bool> closed{false};
+  std::atomic<int> sleepers{0};
+  std::mutex mutex;
+  std::condition_variable condition;
+};
+
+// Reads from one ring and writes to the other, a flush hands the pending bytes over.
+class RingStreamBuffer : public std::streambuf {
+public:
+  RingStreamBuffer(ByteRing &in, ByteRing &out) : in(in), out(out) { setp(put.data(), put.data() + put.size()); }
+
+protected:
+  int_type underflow() override {
+    auto size = in.read(get.data(), get.size());
+    if (size == 0) {
+      return traits_type::eof();
+    }
+    setg(get.data(), get.data(), get.data() + size);
+    return traits_type::to_int_type(get[0]);
+  }
+
+  int_type overflow(int_type c) override {
+    if (!flushPut()) {
+      return traits_type::eof();
+    }
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(c);
+      pbump(1);
+    }
+    return traits_type::not_eof(c);
+  }
+
+  int sync() override { return flushPut() ? 0 : -1; }
+
+private:
+  bool flushPut() {
+    auto size = static_cast<std::size_t>(pptr() - pbase());
+    auto written = out.write(pbase(), size);
+    setp(put.data(), put.data() + put.size());
+    return written == size;
+  }
+
+  ByteRing &in;
+  ByteRing &out;
+  std::array<char, 4096> get;
+  std::array<char, 4096> put;
+};
+
+struct Channel {
+  explicit Channel(std::size_t capacity) : toFirst(capacity), toSecond(capacity) {}
+
+  ByteRing toFirst;
+  ByteRing toSecond;
+};
+
+class InProcessTransport : public Transport {
+public:
+  InProcessTransport(std::shared_ptr<Channel> channel, ByteRing &in, ByteRing &out)
+      : channel(std::move(channel)), in(in), out(out), buffer(in, out), io(&buffer) {
+    io.setf(std::ios_base::unitbuf);
+  }
+
+  ~InProcessTransport() override { close(); }
+
+  std::iostream &stream() override { return io; }
+
+  void close() override {
+    io.flush();
+    out.close();
+    in.close();
+  }
+
+private:
+  std::shared_ptr<Channel> channel;
+  ByteRing &in;
+  ByteRing &out;
+  RingStreamBuffer buffer;
+  std::iostream io;
+};
+
+/*
+  Stream buffer straight over a connected socket. Unlike Boost's socket
+  streambuf, the get and put sides share no state, so one thread may block
+  reading while another writes.
+*/
+class SocketStreamBuffer : public std::streambuf {
+public:
+  explicit SocketStreamBuffer(int fd) : fd(fd) { setp(put.data(), put.data() + put.size()); }
+
+protected:
+  int_type underflow() override {
+    ssize_t size;
+    do {
+      size = ::recv(fd, get.data(), get.size(), 0);
+    } while (size < 0 && errno == EINTR);
+    if (size <= 0) {
+      return traits_type::eof();
+    }
+    setg(get.data(), get.data(), get.data() + size);
+    return traits_type::to_int_type(get[0]);
+  }
+
+  int_type overflow(int_type c) override {
+    if (!flushPut()) {
+      return traits_type::eof();
+    }
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(c);
+      pbump(1);
+    }
+    return traits_type::not_eof(c);
+  }
+
+  int sync() override { return flushPut() ? 0 : -1; }
+
+private:
+  bool flushPut() {
+    const char *data = pbase();
+    auto remaining = pptr() - pbase();
+    setp(put.data(), put.data() + put.size());
+    while (remaining > 0) {
+      // a peer that has gone away fails the write instead of raising SIGPIPE
+      auto sent = ::send(fd, data, remaining, MSG_NOSIGNAL);
+      if (sent < 0 && errno == EINTR) {
+        continue;
+      }
+      if (sent <= 0) {
+        return false;
+      }
+      data += sent;
+      remaining -= sent;
+    }
+    return true;
+  }
+
+  int fd;
+  std::array<char, 4096> get;
+  std::array<char, 4096> put;
+};
+
+// Owns a connected Boost socket and its io_context, and reads and writes it through SocketStreamBuffer.
+template <typename Protocol> class SocketTransport : public Transport {
+public:
+  SocketTransport(std::shared_ptr<boost::asio::io_context> context, typename Protocol::socket socket)
+      : context(std::move(context)), socket(std::move(socket)), buffer(this->socket.native_handle()), io(&buffer) {
+    io.setf(std::ios_base::unitbuf);
+  }
+
+  std::iostream &stream() override { return io; }
+
+  // Shutting down rather than closing wakes a reader blocked on the socket without reusing its descriptor.
+  void close() override {
+    io.flush();
+    boost::system::error_code ignored;
+    socket.shutdown(Protocol::socket::shutdown_both, ignored);
+  }
+
+private:
+  std::shared_ptr<boost::asio::io_context> context;
+  typename Protocol::socket socket;
+  SocketStreamBuffer buffer;
+  std::iostream io;
+};
+
+} // namespace
+
+TransportPtr connectTcp(const std::string &host, const std::string &port) {
+  using boost::asio::ip::tcp;
+  auto context = std::make_shared<boost::asio::io_context>();
+  tcp::socket socket(*context);
+  boost::system::error_code error;
+  auto endpoints = tcp::resolver(*context).resolve(host, port, error);
+  if (!error) {
+    boost::asio::connect(socket, endpoints, error);
+  }
+  if (error) {
+    return nullptr;
+  }
+  socket.set_option(tcp::no_delay(true), error);
+  return std::make_unique<SocketTransport<tcp>>(context, std::move(socket));
+}
+
+TransportPtr connectUnix(const std::string &path) {
+  using boost::asio::local::stream_protocol;
+  auto context = std::make_shared<boost::asio::io_context>();
+  stream_protocol::socket socket(*context);
+  boost::system::error_code error;
+  socket.connect(stream_protocol::endpoint(path), error);
+  if (error) {
+    return nullptr;
+  }
+  return std::make_unique<SocketTransport<stream_protocol>>(context, std::move(socket));
+}
+
+TransportPtr connectTransport(const std::string &host, const std::string &port) {
+  const std::string unixPrefix = "unix:";
+  if (host.compare(0, unixPrefix.size(), unixPrefix) == 0) {
+    return connectUnix(host.substr(unixPrefix.size()));
+  }
+  return connectTcp(host, port);
+}
+
+std::pair<TransportPtr, TransportPtr> unixSocketPair() {
+  using boost::asio::local::stream_protocol;
+  auto context = std::make_shared<boost::asio::io_context>();
+  stream_protocol::socket first(*context);
+  stream_protocol::socket second(*context);
+  boost::asio::local::connect_pair(first, second);
+  return {std::make_unique<SocketTransport<stream_protocol>>(context, std::move(first)),
+          std::make_unique<SocketTransport<stream_protocol>>(context, std::move(second))};
+}
+
+std::pair<TransportPtr, TransportPtr> inProcessPair(std::size_t capacity) {
+  auto channel = std::make_shared<Channel>(capacity);
+  auto &toFirst = channel->toFirst;
+  auto &toSecond = channel->toSecond;
+  return {std::make_unique<InProcessTransport>(channel, toFirst, toSecond),
+          std::make_unique<InProcessTransport>(channel, toSecond, toFirst)};
+}
+
+} // namespace pokerbots::skeleton
@@ -0,0 +1,2313 @@
+#include "bot.h"
+
+#include <skeleton/bounty.h>
+#include <skeleton/card_set.h>
+#include <skeleton/evaluator.h>
+#include <skeleton/log.h>
+#include <skeleton/poker.h>
+#include <skeleton/resolver.h>
+#include <skeleton/river.h>
+#include <time.h>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+
+unsigned short eval5Hand(const Card &c1, const Card &c2, const Card &c3, const Card &c4, const Card &c5)
+{
+    return pokerbots::skeleton::eval5(c1.code, c2.code, c3.code, c4.code, c5.code);
+}
+
+int handRank(unsigned short val)
+{
+    if (val > 6185)
+        return HIGH_CARD; // 1277 high card
+    if (val > 3325)
+        return ONE_PAIR; // 2860 one pair
+    if (val > 2467)
+        return TWO_PAIR; //  858 two pair
+    if (val > 1609)
+        return THREE_OF_A_KIND; //  858 three-kind
+    if (val > 1599)
+        return STRAIGHT; //   10 straights
+    if (val > 322)
+        return FLUSH; // 1277 flushes
+    if (val > 166)
+        return FULL_HOUSE; //  156 full house
+    if (val > 10)
+        return FOUR_OF_A_KIND; //  156 four-kind
+    return STRAIGHT_FLUSH;     //   10 straight-flushes
+}
+
+// For printing final classification
+static const char *HAND_TYPE_NAME[] = {
+    "",
+    "Straight Flush",
+    "Four of a Kind",
+    "Full House",
+    "Flush",
+    "Straight",
+    "Three of a Kind",
+    "Two Pair",
+    "One Pair",
+    "High Card"};
+
+// GENERATE CARD CODE
+
+std::uint32_t generateCardCode(int rankIndex, int suitIndex)
+{
+    // Suits encoding (0x8000 = clubs, 0x4000 = diamonds, 0x2000 = hearts, 0x1000 = spades)
+
+    // T is the 8th rank (0 = 2, 1 = 3, ..., 8 = T, ..., 12 = A)
+    // Hearts is the 3rd suit (0 = clubs, 1 = diamonds, 2 = hearts, 3 = spades)
+
+    // Ensure valid inputs
+    if (rankIndex < 0 || rankIndex > 12 || suitIndex < 0 || suitIndex > 3)
+    {
+        throw std::invalid_argument("Invalid rank or suit index");
+    }
+
+    return pokerbots::skeleton::makeCardCode(rankIndex, suitIndex);
+}
+
+auto generateCardCodeFromString = [](const std::string &cardStr) -> std::uint32_t
+{
+    std::unordered_map<char, int> rankMap = {{'2', 0}, {'3', 1}, {'4', 2}, {'5', 3}, {'6', 4}, {'7', 5}, {'8', 6}, {'9', 7}, {'T', 8}, {'J', 9}, {'Q', 10}, {'K', 11}, {'A', 12}};
+    std::unordered_map<char, int> suitMap = {{'c', 0}, {'d', 1}, {'h', 2}, {'s', 3}};
+    int rankIndex = rankMap[cardStr[0]];
+    int suitIndex = suitMap[cardStr[1]];
+    return generateCardCode(rankIndex, suitIndex);
+};
+
+struct BestHandResult
+{
+    unsigned short minVal;
+    std::vector<Card> bestCombination;
+};
+
+BestHandResult evalHand(const std::vector<Card> &cards)
+{
+    if (cards.size() < 5 || cards.size() > 7)
+    {
+        throw std::invalid_argument("Number of cards must be between 5 and 7.");
+    }
+
+    BestHandResult result;
+    result.minVal = 8000;
+    result.bestCombination = {};
+
+    size_t n = cards.size();
+
+    for (size_t i = 0; i < n - 4; ++i)
+    {
+        for (size_t j = i + 1; j < n - 3; ++j)
+        {
+            for (size_t k = j + 1; k < n - 2; ++k)
+            {
+                for (size_t l = k + 1; l < n - 1; ++l)
+                {
+                    for (size_t m = l + 1; m < n; ++m)
+                    {
+                        unsigned short val = eval5Hand(cards[i], cards[j], cards[k], cards[l], cards[m]);
+
+                        if (val < result.minVal)
+                        {
+                            result.minVal = val;
+                            result.bestCombination = {cards[i], cards[j], cards[k], cards[l], cards[m]};
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return result; // Return the best hand result
+}
+
+// BOUNTY HYPERPARAMETERS
+static const int roundsPerBounty = 25;
+static const double bountyRatio = 1.5;
+static const int bountyConstant = 10;
+
+// written by tools/bucketer, optional
+static const char *bucketTablePath = "data/buckets.bin";
+// written by tools/preflop, optional
+static const char *preflopEquityPath = "data/preflop_equity.bin";
+// written by tools/solver, optional; memory mapped so its size does not matter at startup
+static const char *strategyTablePath = "data/strategy.bin";
+// the blueprint only overrides the hand-tuned strategy when this is set to something other than 0
+static const char *blueprintVariable = "POKERBOT_BLUEPRINT";
+// opponent profiles are kept per POKERBOT_OPPONENT, when it is set
+static const char *opponentVariable = "POKERBOT_OPPONENT";
+static const char *opponentProfileDirectory = "data/opponents";
+static const double profileCarryOver = 0.5; // share of last match's evidence a profile starts with
+
+using namespace pokerbots::skeleton;
+
+// RESOLVER PARAMETERS
+static const double maxResolveSeconds = 0.1;
+static const double resolveClockShare = 0.5; // of the clock left per remaining round
+static const double minResolveSeconds = 0.005;
+static const int minResolveIterations = 8; // fewer than this and the solution is still close to uniform
+static const double rangeSizingSeconds = 0.02; // bestRangeAmount's two enumerations on the turn
+
+// GAME PARAMETERS
+static const int numRounds = NUM_ROUNDS;
+static const int startingStack = STARTING_STACK;
+static const int bigBlindVal = BIG_BLIND;
+static const int smallBlindVal = SMALL_BLIND;
+
+Bot::Bot(std::uint64_t seed)
+    : deckInstance(Rng::stream(seed, 1)), rng(Rng::stream(seed, 0)),
+      featureMemo(seed, numMCTrials / oppHandsPerRunout, oppHandsPerRunout, maxFeatureBatches, &sharedFeatureCache(),
+                  Sampling::STRATIFIED)
+{
+    if (bucketTable.load(bucketTablePath))
+    {
+        POKERBOT_LOG(INFO) << "Loaded card abstraction from " << bucketTablePath;
+    }
+    if (preflopEquity.load(preflopEquityPath))
+    {
+        POKERBOT_LOG(INFO) << "Loaded preflop equities from " << preflopEquityPath;
+    }
+    std::vector<int> preflopRank(NUM_COMBOS);
+    for (int combo = 0; combo < NUM_COMBOS; ++combo)
+    {
+        auto found = regularPreflopDict.find(categorize_cards({cardString(COMBO_CARDS[combo].first), cardString(COMBO_CARDS[combo].second)}));
+        preflopRank[combo] = found != regularPreflopDict.end() ? found->second : static_cast<int>(regularPreflopDict.size()) + 1;
+        preflopOrder.push_back(combo);
+    }
+    std::stable_sort(preflopOrder.begin(), preflopOrder.end(), [&](int a, int b) { return preflopRank[a] < preflopRank[b]; });
+    const char *blueprint = std::getenv(blueprintVariable);
+    if (blueprint && *blueprint && std::string(blueprint) != "0" && strategyTable.load(strategyTablePath))
+    {
+        // the abstraction the table was solved with: our bucket table on the streets it bucketed, its fallback elsewhere
+        strategyCards = std::make_unique<CardAbstraction>(&bucketTable, strategyTable.fallbackBuckets(), strategyTable.bucketedStreets());
+        blueprintCursor = std::make_unique<TreeCursor>(strategyTable.tree());
+        POKERBOT_LOG(INFO) << "Loaded blueprint strategy from " << strategyTablePath;
+        for (int street : {0, 3, 4, 5})
+        {
+            if (strategyCards->numBuckets(street) != strategyTable.buckets()[streetSlot(street)])
+            {
+                POKERBOT_LOG(WARN) << "Blueprint unused on street " << street << ": solved with " << strategyTable.buckets()[streetSlot(street)] << " buckets, " << strategyCards->numBuckets(street) << " available";
+            }
+        }
+    }
+
+    const char *opponent = std::getenv(opponentVariable);
+    if (opponent && *opponent)
+    {
+        std::string name;
+        for (const char *c = opponent; *c; ++c)
+        {
+            name += (std::isalnum(static_cast<unsigned char>(*c)) || *c == '-') ? *c : '_';
+        }
+        opponentProfilePath = std::string(opponentProfileDirectory) + "/" + name + ".bin";
+        // read off the main thread, the first round waits for it
+        opponentProfileLoad = std::async(std::launch::async, [this]() { return opponentModel.load(opponentProfilePath, profileCarryOver); });
+    }
+}
+
+void Bot::handleNewRound(GameInfoPtr gameState, RoundStatePtr roundState, int active)
+{
+    int myBankroll = gameState->bankroll;     // the total number of chips you've gained or lost from the beginning of the game to the start of this round
+    float gameClock = gameState->gameClock;   // the total number of seconds your bot has left to play this game
+    int roundNum = gameState->roundNum;       // the round number from 1 to State.NUM_ROUNDS
+    auto myCards = roundState->hands[active]; // your cards
+    bool bigBlind = (active == 1);            // true if you are the big blind
+
+    if (opponentProfileLoad.valid() && opponentProfileLoad.get())
+    {
+        POKERBOT_LOG(INFO) << "Loaded opponent profile from " << opponentProfilePath;
+        refreshOpponentReads();
+    }
+    if (blueprintCursor)
+    {
+        blueprintCursor->reset();
+    }
+
+    featureMemo.clear();
+    actionSamples = ActionSamples();
+    timesBetPreflop = 0;
+    oppNumReraise = 0;
+    oppNumBetsThisRound = 0;
+    ourRaisesThisRound = 0;
+    ourReRaisesThisRound = 0;
+
+    nitToggle = (myBankroll > 1750) ? false : true;
+    if (!nitToggle)
+    {
+        POKERBOT_LOG(INFO) << "Nit toggle set to FALSE " << nitToggle;
+    }
+
+
+    if (gameClock < 30)
+    {
+        POKERBOT_LOG(INFO) << "Time is out to 30";
+        numMCTrials = 400;
+    }
+    else if (gameClock < 20){
+        POKERBOT_LOG(INFO) << "Time is out to 20";
+        numMCTrials = 250;
+    }
+    else if (gameClock < 10){
+        POKERBOT_LOG(INFO) << "Time is out to 10";
+        numMCTrials = 150;
+    }
+    featureMemo.setRunoutsPerBatch(numMCTrials / oppHandsPerRunout);
+
+    hasBounty = false;
+    bountyRaises = 0;
+    alarmBell = false;
+
+    if (myBankroll > 1000)
+    {
+        bountyRaises++;
+        oppReRaiseAsBBMore = true;
+        oppRaiseAsDealerLess = true;
+        //std::cout << "No more bounty bluff raises" << std::endl;
+    }
+
+    if ((myBankroll > 1000 && roundNum > 500) || (myBankroll > 1500 && roundNum > 300))
+    {
+        reraiseLess = true;
+    }
+    else
+    {
+        reraiseLess = false;
+    }
+
+    if (roundNum == 1000)
+    {
+        if (active && myBankroll <= 2 && myBankroll >= -1)
+        {
+            POKERBOT_LOG(INFO) << "AAAAAAHHHHHH";
+            shoveTime = true;
+        }
+        else if (!active && myBankroll <= 1 && myBankroll >= -1)
+        {
+            POKERBOT_LOG(INFO) << "AAAAAAHHHHHH";
+            shoveTime = true;
+        }
+        else
+        {
+            shoveTime = false;
+        }
+    }
+    else
+    {
+        shoveTime = false;
+    }
+
+    numOppChecks = 0;
+    numSelfChecks = 0;
+    oppLastContribution = 0;
+
+    twoCheckBluff = false;
+    threeCheckBluff = false;
+    bountyBluff = false;
+
+    oppBetLastRound = false;
+
+    int remainingRounds = numRounds - roundNum + 1;
+
+    // exact odds of the match for whoever folds every remaining round, real blinds and bounties included
+    double foldOutWin = foldOutOdds.winProbability(remainingRounds, myBankroll, bigBlind);
+    double oppFoldOutWin = foldOutOdds.winProbability(remainingRounds, -myBankroll, !bigBlind);
+
+    POKERBOT_LOG(INFO) << "\n#" << totalRounds;
+    POKERBOT_LOG(DEBUG) << "fold-out win odds: " << foldOutWin << ", opponent's: " << oppFoldOutWin;
+    if (foldOutWin >= lockInConfidence)
+    {
+        alreadyWon = true;
+        POKERBOT_LOG(INFO) << "Already won: YIPPEE!";
+    }
+    
+    // a style switch tuned by hand, not an odds decision, so it keeps its trigger point: behind by 0.7 of
+    // what folding out costs with one standard deviation more opponent bounties than expected
+    double standardDeviation = std::sqrt(remainingRounds * 0.15 * 0.85);
+    double aggBankrollThreshold = 1.5 * remainingRounds + bountyConstant * (remainingRounds * 0.15 + standardDeviation) + 53;
+    if (myBankroll < -1 * (int)ceil(aggBankrollThreshold * 0.7) && roundNum > 299)
+    {
+        aggressiveMode = true;
+        POKERBOT_LOG(INFO) << "agg mode true";
+    }
+    else
+    {
+        aggressiveMode = false;
+        //std::cout << "agg mode false" << std::endl;
+    }
+
+    if (myBankroll > foldOutOdds.worstCase(remainingRounds, bigBlind))
+    {
+        POKERBOT_LOG(INFO) << "WOOWEE";
+        autoFold = true;
+    }
+    else
+    {
+        autoFold = false;
+    }
+
+    
+}
+
+void Bot::handleShowdown(GameInfoPtr, const ShowdownRecord &record, int)
+{
+    opponentModel.observeShowdown(record);
+    POKERBOT_LOG(INFO) << "Showdown: opp equity " << record.equity[0] << " " << record.equity[1] << " " << record.equity[2] << " " << record.equity[3];
+}
+
+void Bot::refreshOpponentReads()
+{
+    // the reads fire where the old counters had them: the check-fold read after a run of more than 30 passive
+    // rounds, the others once their rate has about as many observations as the counters waited for
+    if (opponentModel.run(OpponentModel::PASSIVE_ROUND) > 30)
+    {
+        POKERBOT_LOG(INFO) << "opp is cf bot";
+        oppCheckFold = true;
+    }
+    else
+    {
+        oppCheckFold = false;
+    }
+
+    double oppPotBetPercent = opponentModel.frequency(OpponentModel::POT_BET);
+    double oppBetPercent = opponentModel.frequency(OpponentModel::BET);
+    double oppReraisePct = opponentModel.frequency(OpponentModel::RERAISE);
+    POKERBOT_LOG(INFO) << "Opp Bets: " << opponentModel.observations(OpponentModel::POT_BET) << " | Opp Pot Bets: " << oppPotBetPercent << " | Opp Bets vs Checks: " << oppBetPercent << " | Opp Reraises: " << oppReraisePct << " | Opp Reraises this round: " << oppNumReraise << " | Opp Bets this round: " << oppNumBetsThisRound;
+
+    if (opponentModel.observations(OpponentModel::POT_BET) > 8)
+    {
+        if (oppPotBetPercent > 0.69)
+        {
+            POKERBOT_LOG(INFO) << "HUGE UNNIT";
+            unnitBigBetFact = 2;
+        }
+        else if (oppPotBetPercent > 0.4)
+        {
+            POKERBOT_LOG(INFO) << "UNNIT";
+            unnitBigBetFact = 1;
+        }
+        else
+        {
+            unnitBigBetFact = 0;
+        }
+    }
+
+    if (opponentModel.observations(OpponentModel::BET) > 15)
+    {
+        bluffCatcherFact = oppBetPercent > 0.44069 ? 1 : 0;
+    }
+
+    if (opponentModel.observations(OpponentModel::RERAISE) >= 15)
+    {
+        oppReraiseFact = oppReraisePct > 0.125 ? 1 : 0;
+    }
+
+    double oppOpenRaisePct = opponentModel.frequency(OpponentModel::OPEN_RAISE);
+    double oppThreeBetPct = opponentModel.frequency(OpponentModel::THREE_BET, 0, 1);
+    POKERBOT_LOG(INFO) << "Opp open raises: " << oppOpenRaisePct << " || Opp reraises as BB: " << oppThreeBetPct;
+
+    // open raises are counted per dealer hand, which is half of the rounds, so 40 of them stand in for the old first 80 rounds
+    bool earlyMatch = opponentModel.observations(OpponentModel::OPEN_RAISE) < 40;
+    if (oppOpenRaisePct < 0.3 || earlyMatch)
+    {
+        oppRaiseAsDealerLess = true;
+        POKERBOT_LOG(INFO) << "ORADL = t";
+    }
+    else
+    {
+        oppRaiseAsDealerLess = false;
+    }
+
+    if ((oppThreeBetPct > 0.13069 && opponentModel.observations(OpponentModel::THREE_BET) > 15) || earlyMatch)
+    {
+        oppReRaiseAsBBMore = true;
+        POKERBOT_LOG(INFO) << "ORRBBM = t";
+    }
+    else
+    {
+        oppReRaiseAsBBMore = false;
+    }
+}
+
+void Bot::handleRoundOver(GameInfoPtr gameState, TerminalStatePtr terminalState, int active)
+{
+    int myDelta = terminalState->deltas[active];                                                   // your bankroll change from this round
+    auto previousState = std::static_pointer_cast<const RoundState>(terminalState->previousState); // RoundState before payoffs
+    int street = previousState->street;                                                            // 0, 3, 4, or 5 representing when this round ended
+    auto myCards = previousState->hands[active];                                                   // your cards
+    auto oppCards = previousState->hands[1 - active];                                              // opponent's cards or "" if not revealed
+
+    if (gameState->roundNum == NUM_ROUNDS)
+    {
+        auto features = sharedFeatureCache().stats();
+        auto buckets = bucketTable.fallbackStats();
+        POKERBOT_LOG(INFO) << "Feature cache: " << features.hits << " hits, " << features.misses << " misses, " << features.evictions << " evictions";
+        POKERBOT_LOG(INFO) << "Bucket fallback cache: " << buckets.hits << " hits, " << buckets.misses << " misses";
+    }
+
+    bool myBountyHit = terminalState->bounty_hits[active];      // true if your bounty hit this round
+    bool oppBountyHit = terminalState->bounty_hits[1 - active]; // true if your opponent's bounty hit this round
+
+    char bounty_rank = previousState->bounties[active]; // your bounty rank
+
+
+    opponentModel.observeRound(*terminalState, 1 - active);
+    refreshOpponentReads();
+
+    // // The following is a demonstration of accessing illegal information (will not work)
+    // char opponent_bounty_rank = previousState->bounties[1 - active]; // attempting to grab opponent's bounty rank
+    // if (myBountyHit)
+    // {
+    //     std::cout << "I hit my bounty of " << bounty_rank << "!" << std::endl;
+    // }
+    // if (oppBountyHit)
+    // {
+    //     std::cout << "Opponent hit their bounty of " << opponent_bounty_rank << "!" << std::endl;
+    // }
+
+    totalRounds++;
+
+    if (twoCheckBluff)
+    {
+        //std::cout << "Two check bluff happened this round" << std::endl;
+        pmTwoCheckBluff += myDelta;
+        twoCheckBluffCounter++;
+    }
+    if (threeCheckBluff)
+    {
+        //std::cout << "Three check bluff happened this round" << std::endl;
+        pmThreeCheckBluff += myDelta;
+        threeCheckBluffCounter++;
+    }
+    if (bountyBluff)
+    {
+        //std::cout << "Bounty bluff happened this round" << std::endl;
+        pmBountyBluff += myDelta;
+        bountyBluffCounter++;
+    }
+
+    if (pmTwoCheckBluff < -300 && twoCheckBluffCounter > 7)
+    {
+        permanentNoTwoCheck = true;
+        POKERBOT_LOG(INFO) << "Perm no 2c";
+    }
+    if (pmThreeCheckBluff < -300 && threeCheckBluffCounter > 7)
+    {
+        permanentNoTwoCheck = true;
+        POKERBOT_LOG(INFO) << "Perm no 3c";
+    }
+    if (pmBountyBluff < -300 && bountyBluffCounter > 7)
+    {
+        permanentNoBountyBluff = true;
+        POKERBOT_LOG(INFO) << "Perm no bb";
+    }
+
+
+    if (totalRounds == numRounds + 1)
+    {
+        POKERBOT_LOG(INFO) << "\n";
+        POKERBOT_LOG(INFO) << "two check bluff: " << pmTwoCheckBluff;
+        POKERBOT_LOG(INFO) << "three check bluff: " << pmThreeCheckBluff;
+        POKERBOT_LOG(INFO) << "bounty bluff: " << pmBountyBluff;
+    }
+}
+
+void Bot::handleGameOver(GameInfoPtr)
+{
+    if (!opponentProfilePath.empty())
+    {
+        if (opponentProfileLoad.valid())
+        {
+            opponentProfileLoad.wait();
+        }
+        if (!opponentModel.save(opponentProfilePath))
+        {
+            POKERBOT_LOG(ERROR) << "Unable to write opponent profile " << opponentProfilePath;
+        }
+    }
+}
+
+int Bot::get_rank_index(char rank)
+{
+    switch (rank)
+    {
+    case 'A':
+        return 0;
+    case 'K':
+        return 1;
+    case 'Q':
+        return 2;
+    case 'J':
+        return 3;
+    case 'T':
+        return 4;
+    case '9':
+        return 5;
+    case '8':
+        return 6;
+    case '7':
+        return 7;
+    case '6':
+        return 8;
+    case '5':
+        return 9;
+    case '4':
+        return 10;
+    case '3':
+        return 11;
+    case '2':
+        return 12;
+    default:
+        return 13; // Invalid rank
+    }
+}
+
+std::string Bot::categorize_cards(const std::vector<std::string> &cards)
+{
+    if (cards.size() != 2)
+    {
+        POKERBOT_LOG(ERROR) << "Error: categorize_cards requires exactly two cards.";
+        return "";
+    }
+
+    char rank1 = cards[0][0];
+    char rank2 = cards[1][0];
+    char suit1 = cards[0][1];
+    char suit2 = cards[1][1];
+
+    int rank_idx1 = get_rank_index(rank1);
+    int rank_idx2 = get_rank_index(rank2);
+
+    if (rank_idx1 == 13 || rank_idx2 == 13)
+    {
+        POKERBOT_LOG(ERROR) << "Error: Invalid card rank encountered.";
+        return "";
+    }
+
+    std::string hpair;
+    if (rank_idx1 < rank_idx2)
+    {
+        hpair = std::string(1, rank1) + std::string(1, rank2);
+    }
+    else
+    {
+        hpair = std::string(1, rank2) + std::string(1, rank1);
+    }
+    char onsuit = (suit1 == suit2) ? 's' : 'o';
+
+    return hpair + onsuit;
+}
+
+double Bot::preflopEquityAgainst(const std::vector<std::string> &cards, double share)
+{
+    Range range{};
+    int combos = std::clamp(static_cast<int>(std::ceil(share * NUM_COMBOS)), 1, NUM_COMBOS);
+    for (int i = 0; i < combos; ++i)
+    {
+        range[preflopOrder[i]] = 1.0f;
+    }
+    return preflopEquity.equity(comboIndex(cardIndex(cards[0]), cardIndex(cards[1])), range);
+}
+
+int Bot::noIllegalRaises(int myBet, RoundStatePtr roundState, bool active)
+{
+    int myPip = roundState->pips[active];      // the number of chips you have contributed to the pot this round of betting
+    int oppPip = roundState->pips[1 - active]; // the number of chips your opponent has contributed to the pot this round of betting
+
+    std::array<int, 2> raiseBounds = roundState->raiseBounds();
+    int min_raise = raiseBounds[0];
+    int max_raise = raiseBounds[1];
+
+    if (myBet < min_raise)
+        myBet = min_raise;
+    if (myBet > max_raise)
+        myBet = max_raise;
+    return myBet;
+}
+
+Action Bot::getPreflopAction(RoundStatePtr roundState, int active)
+{
+    auto legalActions =
+        roundState->legalActions();  // the actions you are allowed to take
+    int street = roundState->street; // 0, 3, 4, or 5 representing pre-flop, flop, turn, or river respectively
+    // auto myCards = roundState->hands[active];        // your cards
+    int oppPip = roundState->pips[1 - active];       // the number of chips your opponent has contributed to the pot this round of betting
+    int myPip = roundState->pips[active];
+    int continueCost = oppPip - myPip;               // the number of chips needed to stay in the pot
+    int myStack = roundState->stacks[active];        // the number of chips you have remaining
+    int oppStack = roundState->stacks[1 - active];   // the number of chips your opponent has remaining
+    int myContribution = STARTING_STACK - myStack;   // the number of chips you have contributed to the pot
+    int oppContribution = STARTING_STACK - oppStack; // the number of chips your opponent has contributed to the pot
+    char myBounty = roundState->bounties[active];    // your current bounty rank
+    bool bigBlind = (active == 1);                   // true if you are the big blind
+
+    int pot = myContribution + oppContribution;
+    int myBet = 0;
+
+    std::vector<std::string> myCards(roundState->hands[active].begin(), roundState->hands[active].end());
+    std::string newCards = categorize_cards(myCards);
+
+    int handStrength = -1;
+
+    if (!aggressiveMode)
+    {
+        handStrength = regularPreflopDict.find(newCards)->second;
+    }
+    else
+    {
+        handStrength = aggPreflopDict.find(newCards)->second;
+    }
+
+    int oldHandStrength = handStrength;
+
+    if (newCards.find(myBounty) != std::string::npos)
+    {
+        POKERBOT_LOG(DEBUG) << "Bounty ACTIVE with " << myBounty;
+        hasBounty = true;
+        handStrength = 1;
+    }
+    else
+    {
+        std::array<int, 2> holeCards = {cardIndex(myCards[0]), cardIndex(myCards[1])};
+        POKERBOT_LOG(DEBUG) << "Bounty " << myBounty << " hits by the river with probability " << bountyHitProbability(holeCards, {}, rankIndex(myBounty));
+    }
+
+
+
+    POKERBOT_LOG(DEBUG) << "Hand strength: " << handStrength;
+
+    if (!bigBlind && timesBetPreflop == 0) //dealer, first to act
+    {
+        if (shoveTime)
+        {
+            timesBetPreflop++;
+            POKERBOT_LOG(DEBUG) << "Shove time all in";
+            return {Action::Type::RAISE, noIllegalRaises(400, roundState, active)};
+        }
+        if (oppCheckFold)
+        {
+            if (hasBounty)
+            {
+                timesBetPreflop++;
+                POKERBOT_LOG(DEBUG) << "min raise for cf";
+                return {Action::Type::RAISE, noIllegalRaises(3, roundState, active)};
+            }
+            else
+            {
+                timesBetPreflop++;
+                POKERBOT_LOG(DEBUG) << "call for cf";
+                return {Action::Type::CALL};
+            }
+        }
+
+        if (hasBounty)
+        {
+            if (aggressiveMode)
+            {
+                POKERBOT_LOG(DEBUG) << "Agg bad bounty 7x raise from sb";
+                timesBetPreflop++;
+                myBet = 7 * pot;
+                return {Action::Type::RAISE, noIllegalRaises(myBet, roundState, active)};
+            }
+            else if (bluffCatcherFact == 0 || oldHandStrength < 88)
+            {
+                POKERBOT_LOG(DEBUG) << "3x raise from sb with bounty";
+                timesBetPreflop++;
+                myBet = 3 * pot;
+                return {Action::Type::RAISE, noIllegalRaises(myBet, roundState, active)};
+            }
+            else
+            {
+                timesBetPreflop++;
+                POKERBOT_LOG(DEBUG) << "Call from sb with bad bounty";
+                return {Action::Type::CALL};
+
+                // MAYBE CALL ALWAYS HERE TODO!!!!
+            }
+        }
+        else
+        {
+            if (aggressiveMode)
+            {
+                if (handStrength < 26)
+                {
+                    POKERBOT_LOG(DEBUG) << "Agg 7x raise from sb";
+                    timesBetPreflop++;
+                    myBet = 7 * pot;
+                    return {Action::Type::RAISE, noIllegalRaises(myBet, roundState, active)};
+                }
+                else if (handStrength < 88)
+                {
+                    POKERBOT_LOG(DEBUG) << "Agg 4x raise from sb";
+                    timesBetPreflop++;
+                    myBet = 3 * pot;
+                    return {Action::Type::RAISE, noIllegalRaises(myBet, roundState, active)};
+                }
+                else
+                {
+                    timesBetPreflop++;
+                    POKERBOT_LOG(DEBUG) << "Call from sb with bad bounty";
+                    return {Action::Type::CALL};
+                }
+            }
+            else if (handStrength < 26)
+            {
+                POKERBOT_LOG(DEBUG) << "3x raise from sb";
+                timesBetPreflop++;
+                myBet = 3 * pot;
+                return {Action::Type::RAISE, noIllegalRaises(myBet, roundState, active)};
+            }
+            if (bluffCatcherFact == 1)
+            {
+                if ((handStrength < 58 && !oppReRaiseAsBBMore) || (handStrength < 48 && oppReRaiseAsBBMore))
+                {
+                    POKERBOT_LOG(DEBUG) << "2x raise from sb";
+                    timesBetPreflop++;
+                    myBet = 2 * pot;
+                    return {Action::Type::RAISE, noIllegalRaises(myBet, roundState, active)};
+                }
+                else
+                {
+                    //std::cout << "Fold from sb" << std::endl;
+                    return {Action::Type::FOLD};
+                }
+            }
+            else if ((handStrength < 88 && !oppReRaiseAsBBMore) || (handStrength < 60 && oppReRaiseAsBBMore))
+            {
+                POKERBOT_LOG(DEBUG) << "2x raise from sb";
+                timesBetPreflop++;
+                myBet = 2 * pot;
+                return {Action::Type::RAISE, noIllegalRaises(myBet, roundState, active)};
+            }
+            else
+            {
+                //std::cout << "Fold from sb" << std::endl;
+                return {Action::Type::FOLD};
+            }
+        }
+    }
+    else if (bigBlind && timesBetPreflop == 0) //big blind, haven't acted yet
+    {
+        if (shoveTime)
+        {
+            if (legalActions.find(Action::Type::RAISE) != legalActions.end())
+            {
+                timesBetPreflop++;
+                POKERBOT_LOG(DEBUG) << "Shove time all in";
+                return {Action::Type::RAISE, noIllegalRaises(400, roundState, active)};
+            }
+            else
+            {
+                POKERBOT_LOG(DEBUG) << "Agg call from bb with bounty";
+                timesBetPreflop++;
+                return {Action::Type::CALL};
+            }
+        }
+        if (aggressiveMode)
+        {
+            if (hasBounty)
+            {
+                if (oppPip == 2)
+                {
+                    timesBetPreflop++;
+                    myBet = 7 * pot;
+                    POKERBOT_LOG(DEBUG) << "Agg 7x raise from bb from call with bounty";
+                    return {Action::Type::RAISE, noIllegalRaises(myBet, roundState, active)};
+                }
+                else if (oldHandStrength < 26)
+                {
+                    timesBetPreflop++;
+                    POKERBOT_LOG(DEBUG) << "Agg all in from bb with bounty";
+                    return {Action::Type::RAISE, noIllegalRaises(400, roundState, active)};
+                }
+                else if (oldHandStrength < 56)
+                {   
+                    timesBetPreflop++;
+                    myBet = 4 * pot;
+                    POKERBOT_LOG(DEBUG) << "Agg 7x raise from bb with bounty";
+                    return {Action::Type::RAISE, noIllegalRaises(myBet, roundState, active)};
+                }
+                else if (oppPip < 50)
+                {   
+                    POKERBOT_LOG(DEBUG) << "Agg call from bb with bounty";
+                    timesBetPreflop++;
+                    return {Action::Type::CALL};
+                }
+                else
+                {
+                    return {Action::Type::FOLD};
+                }
+            }
+            else
+            {
+                if (oppPip == 2 && handStrength < 60)
+                {
+                    timesBetPreflop++;
+                    myBet = 4 * pot;
+                    POKERBOT_LOG(DEBUG) << "Agg 7x raise from bb from call";
+                    return {Action::Type::RAISE, noIllegalRaises(myBet, roundState, active)};
+                }
+                else if (handStrength < 15)
+                {
+                    if (legalActions.find(Action::Type::RAISE) != legalActions.end())
+                    {
+                        timesBetPreflop++;
+                        POKERBOT_LOG(DEBUG) << "Agg all in from bb";
+                        return {Action::Type::RAISE, noIllegalRaises(400, roundState, active)};
+                    }
+                    else
+                    {
+                        timesBetPreflop++;
+                        POKERBOT_LOG(DEBUG) << "Agg call from bb";
+                        return {Action::Type::CALL};
+                    }
+                }
+                else if (handStrength < 28)
+                {   
+                    if (legalActions.find(Action::Type::RAISE) != legalActions.end())
+                    {
+                        timesBetPreflop++;
+                        myBet = 7 * pot;
+                        POKERBOT_LOG(DEBUG) << "Agg 7x raise from bb";
+                        return {Action::Type::RAISE, noIllegalRaises(myBet, roundState, active)};
+                    }
+                    else
+                    {
+                        timesBetPreflop++;
+                        POKERBOT_LOG(DEBUG) << "Agg call from bb";
+                        return {Action::Type::CALL};
+                    }
+                }
+                else if (oppPip < 50 && handStrength < 88)
+                {   
+                    timesBetPreflop++;
+                    POKERBOT_LOG(DEBUG) << "Agg call from bb";
+                    return {Action::Type::CALL};
+                }
+                else if (legalActions.find(Action::Type::CHECK) != legalActions.end())
+                {
+                    POKERBOT_LOG(DEBUG) << "Opp calls as dealer, check after failed 3x raise as bb";
+                    return {Action::Type::CHECK};
+                }
+                else
+                {
+                    return {Action::Type::FOLD};
+                }
+            }
+
+        }
+
+        if (oppPip == 2) //Opponent calls as dealer
+        {
+            if (handStrength <= 69 && (legalActions.find(Action::Type::RAISE) != legalActions.end())) //raise with strong hands or bounty
+            {
+                timesBetPreflop++;
+                myBet = 3 * pot;
+                POKERBOT_LOG(DEBUG) << "Opp calls as dealer, 3x raise from bb";
+                return {Action::Type::RAISE, noIllegalRaises(myBet, roundState, active)};
+            }
+            else
+            {
+                POKERBOT_LOG(DEBUG) << "Opp calls as dealer, check after failed 3x raise as bb";
+                return {Action::Type::CHECK};
+            }
+        }
+
+        if (opponentModel.frequency(OpponentModel::BIG_OPEN_RAISE) > 0.20)
+        {
+            bbPipThreshold = 25;
+        }
+        else{
+            bbPipThreshold = 12;
+        }
+        POKERBOT_LOG(DEBUG) << bbPipThreshold;
+
+
+        if (((((handStrength < 9 || (handStrength <= 61 && oppPip <= 5) || (handStrength <= 46 && oppPip <= bbPipThreshold) || (handStrength <= 14 && oppPip <= 25)) && !oppRaiseAsDealerLess) ||
+            ((handStrength < 9 || (handStrength <= 41 && oppPip <= 5) || (handStrength <= 32 && oppPip <= bbPipThreshold) || (handStrength <= 9 && oppPip <= 25)) && oppRaiseAsDealerLess)) && bluffCatcherFact == 0) ||
+            ((((handStrength < 9 || (handStrength <= 46 && oppPip <= 5) || (handStrength <= 31 && oppPip <= bbPipThreshold) || (handStrength <= 14 && oppPip <= 25)) && !oppRaiseAsDealerLess) ||
+            ((handStrength < 9 || (handStrength <= 32 && oppPip <= 5) || (handStrength <= 25 && oppPip <= bbPipThreshold) || (handStrength <= 9 && oppPip <= 25)) && oppRaiseAsDealerLess)) && bluffCatcherFact == 1)
+        )  //Always get here w bounty
+        {
+            timesBetPreflop++;
+            myBet = 3 * pot;
+
+            if (oldHandStrength >= 9 && hasBounty) //weak hands with bounty
+            {
+                if (((((oppPip <= 6) || (oldHandStrength <= 180 && oppPip <= bbPipThreshold) || (oldHandStrength <= 18 && oppPip <= 30) && !oppRaiseAsDealerLess) ||
+                    ((oldHandStrength <= 88 && oppPip <= bbPipThreshold) || (oldHandStrength <= 14 && oppPip <= 30) && oppRaiseAsDealerLess)) && bluffCatcherFact == 0) ||
+                    ((((oppPip <= 6) || (oldHandStrength <= 61 && oppPip <= bbPipThreshold) || (oldHandStrength <= 14 && oppPip <= 30) && !oppRaiseAsDealerLess) ||
+                    ((oldHandStrength <= 41 && oppPip <= bbPipThreshold) || (oldHandStrength <= 14 && oppPip <= 30) && oppRaiseAsDealerLess)) && bluffCatcherFact == 1)
+                ) //when to reraise with bounty
+                {
+                    if (legalActions.find(Action::Type::RAISE) != legalActions.end())
+                    {
+                        POKERBOT_LOG(DEBUG) << "3x raise from bb with bounty";
+                        return {Action::Type::RAISE, noIllegalRaises(myBet, roundState, active)};
+                    }
+                    else if (legalActions.find(Action::Type::CALL) != legalActions.end())
+                    {
+                        POKERBOT_LOG(DEBUG) << "Call after failed 3x raise from bb with bounty";
+                        return {Action::Type::CALL};
+                    }
+                    else
+                    {
+                        POKERBOT_LOG(WARN) << "Error: No legal actions found with bounty";
+                    }
+                }
+                else if (oppPip > 150)
+                {
+                    if (oldHandStrength <= 10) //calling all in as bb with bounty
+                    {
+                        if (legalActions.find(Action::Type::CALL) != legalActions.end())
+                        {
+                            POKERBOT_LOG(DEBUG) << "Call huge bet from oppoent as dealer from bb with bounty";
+                            return {Action::Type::CALL};
+                        }
+                        else
+                        {
+                            POKERBOT_LOG(WARN) << "Error: No legal actions found with bounty";
+                        }
+                    }
+                    else
+                    {
+                        POKERBOT_LOG(DEBUG) << "Bounty hand fold as bb to large bet";
+                        return {Action::Type::FOLD};
+                    }
+                }
+                else if ((oppPip <= 12 && oldHandStrength <= 110) || (oppPip > 12 && oppPip <= 25 && oldHandStrength < 88)) //fold super shitters with bounty else call, great pot odds. Note rarely get here - only if opponent raises between 13-20.
+                {
+                    if (legalActions.find(Action::Type::CALL) != legalActions.end())
+                    {
+                        POKERBOT_LOG(DEBUG) << "Call from bb otherwise with bounty";
+                        return {Action::Type::CALL};
+                    }
+                    else
+                    {
+                        POKERBOT_LOG(DEBUG) << "Check after failed call from bb otherwise with bounty";
+                        return {Action::Type::CHECK};
+                    }
+                }
+                else if (oppPip > 25 && oppPip <= 150 && oldHandStrength < (54 - pow((oppPip - 2) / 398.0, 1.0 / 3.0) * (61))) // when to call with bounty in bb otherwise
+                {
+                    if (legalActions.find(Action::Type::CALL) != legalActions.end())
+                    {
+                        POKERBOT_LOG(DEBUG) << "Call from bb otherwise with bounty";
+                        return {Action::Type::CALL};
+                    }
+                    else
+                    {
+                        POKERBOT_LOG(DEBUG) << "Check after failed call from bb otherwise with bounty";
+                        return {Action::Type::CHECK};
+                    }
+                }
+                else 
+                {
+                    //std::cout << "Bounty hand fold as bb" << std::endl;
+                    return {Action::Type::FOLD};
+                }
+            }
+           
+            if (legalActions.find(Action::Type::RAISE) != legalActions.end())
+            {
+                POKERBOT_LOG(DEBUG) << "3x raise from bb";
+                return {Action::Type::RAISE, noIllegalRaises(myBet, roundState, active)};
+            }
+            else if (legalActions.find(Action::Type::CALL) != legalActions.end())
+            {
+                POKERBOT_LOG(DEBUG) << "Call after failed 3x raise from bb";
+                return {Action::Type::CALL};
+            }
+            else
+            {
+                POKERBOT_LOG(WARN) << "Error: No legal actions found";
+            }
+        }
+        else if (oppPip > 150)
+        {
+            // a raise this big comes from the strongest part of the opening range: the top tenth of hands,
+            // or fewer once we have seen the opponent open with less than that
+            bool priced = false;
+            if (preflopEquity.loaded())
+            {
+                double share = opponentModel.observations(OpponentModel::OPEN_RAISE) >= 20 ? std::min(0.1, opponentModel.frequency(OpponentModel::OPEN_RAISE)) : 0.1;
+                double equity = preflopEquityAgainst(myCards, share);
+                double required = static_cast<double>(continueCost) / (pot + continueCost);
+                POKERBOT_LOG(DEBUG) << "Preflop equity " << equity << " against the top " << share << " of hands, " << required << " needed";
+                priced = equity > required + 0.03;
+            }
+            if (oldHandStrength <= 8 || priced) //calling all in as bb without bounty
+            {
+                if (legalActions.find(Action::Type::CALL) != legalActions.end())
+                {
+                    POKERBOT_LOG(DEBUG) << "Call huge bet from oppoent as dealer from bb";
+                    return {Action::Type::CALL};
+                }
+                else
+                {
+                    POKERBOT_LOG(WARN) << "Error: No legal actions found";
+                }
+            }
+            else
+            {
+                POKERBOT_LOG(DEBUG) << "fold as bb to large bet";
+                return {Action::Type::FOLD};
+            }
+        }
+        else if (handStrength < (85 + 1 - pow((oppPip - 2) / 198.0, 1.0 / 3.0) * (88 + 1 - 5)) && oppPip <= 150) //same as before
+        {
+            if (legalActions.find(Action::Type::CALL) != legalActions.end())
+            {
+                POKERBOT_LOG(DEBUG) << "Call from bb otherwise";
+                return {Action::Type::CALL};
+            }
+            else
+            {
+                POKERBOT_LOG(WARN) << "Error: Check after failed call from bb otherwise";
+                return {Action::Type::CHECK};
+            }
+        }
+        else
+        {
+            if (legalActions.find(Action::Type::CHECK) != legalActions.end())
+            {
+                POKERBOT_LOG(WARN) << "Error: Failed Check from bb otherwise";
+                return {Action::Type::CHECK};
+            }
+            else
+            {
+                //std::cout << "Fold from bb" << std::endl;
+                return {Action::Type::FOLD};
+            }
+        }
+    }
+    else if (aggressiveMode)
+    {
+        if (hasBounty)
+        {
+            if (oldHandStrength < 26)
+            {
+                if (legalActions.find(Action::Type::RAISE) != legalActions.end())
+                {
+                    timesBetPreflop++;
+                    POKERBOT_LOG(DEBUG) << "Agg all in with bounty";
+                    return {Action::Type::RAISE, noIllegalRaises(400, roundState, active)};
+                }
+                else
+                {
+                    timesBetPreflop++;
+                    POKERBOT_LOG(DEBUG) << "Agg call from bb";
+                    return {Action::Type::CALL};
+                }    
+            }
+            else if (continueCost < 50)
+            {
+                POKERBOT_LOG(DEBUG) << "Agg call with bounty";
+                return {Action::Type::CALL};
+            }
+            else
+            {
+                return {Action::Type::FOLD};
+            }
+        }
+        else
+        {
+            if (handStrength < 15)
+            {
+                if (legalActions.find(Action::Type::RAISE) != legalActions.end())
+                {
+                    timesBetPreflop++;
+                    POKERBOT_LOG(DEBUG) << "Agg all in without bounty";
+                    return {Action::Type::RAISE, noIllegalRaises(400, roundState, active)};
+                }
+                else
+                {
+                    timesBetPreflop++;
+                    POKERBOT_LOG(DEBUG) << "Agg call from bb";
+                    return {Action::Type::CALL};
+                }  
+            }
+            else if (continueCost < 50 && handStrength < 40)
+            {
+                POKERBOT_LOG(DEBUG) << "Agg call";
+                return {Action::Type::CALL};
+            }
+            else
+            {
+                return {Action::Type::FOLD};
+            }
+        }    
+    }
+    else if (!bigBlind && timesBetPreflop == 1) //We are dealer, raise, get reraised from bb
+    {
+        if (hasBounty) 
+        {
+            if (((oldHandStrength <= 8 || (oldHandStrength <= 12 && oppPip <= 50)) && !oppReRaiseAsBBMore) ||
+                ((oldHandStrength <= 16 || (oldHandStrength <= 19 && oppPip <= 50)) && oppReRaiseAsBBMore) 
+            ) // reraise w bounty - can change if if we notice opp reraising as bb often.
+            {
+                timesBetPreflop++;
+                myBet = 2 * pot;
+                if (legalActions.find(Action::Type::RAISE) != legalActions.end())
+                {
+                    POKERBOT_LOG(DEBUG) << "2x reraise from raise with bounty";
+                    return {Action::Type::RAISE, noIllegalRaises(myBet, roundState, active)};
+                }
+                else if (legalActions.find(Action::Type::CALL) != legalActions.end())
+                {
+                    POKERBOT_LOG(DEBUG) << "Call after failed 2x reraise from raise with bounty";
+                    return {Action::Type::CALL};
+                }
+                else
+                {
+                    POKERBOT_LOG(WARN) << "Error: No legal actions found";
+                }
+            }
+            else if (oppPip >= 150) 
+            {
+                if (oldHandStrength <= 10) //TODO - dealing with all in bots
+                {
+                    if (legalActions.find(Action::Type::CALL) != legalActions.end())
+                    {
+                        POKERBOT_LOG(DEBUG) << "Call huge raise from bb with bounty";
+                        return {Action::Type::CALL};
+                    }
+                    else
+                    {
+                        POKERBOT_LOG(WARN) << "Error: Check after failed call from reraise otherwise";
+                        return {Action::Type::CHECK};
+                    }
+                }
+                else
+                {
+                    POKERBOT_LOG(DEBUG) << "Fold to huge bet from bb with bounty";
+                    return {Action::Type::FOLD};
+                }
+            }
+            else if (oppPip > 40 && oppPip <= 150 && (oldHandStrength < (92 - pow((oppPip - 2) / 198.0, 1.0 / 3.0) * 90))) //call with bounty as dealer from bb raise
+            {
+                if (legalActions.find(Action::Type::CALL) != legalActions.end())
+                {
+                    POKERBOT_LOG(DEBUG) << "Call from large reraise from bb with bounty";
+                    return {Action::Type::CALL};
+                }
+                else
+                {
+                    POKERBOT_LOG(WARN) << "Error: Check after failed call from reraise otherwise";
+                    return {Action::Type::CHECK};
+                }
+            }
+            else if (oppPip <= 40 && oldHandStrength <= 87) //can call with most hands to 4-bets with bounty. In og preflop this was 110, chanmged to 88 to cut out some shitters
+            {
+                if (legalActions.find(Action::Type::CALL) != legalActions.end())
+                {
+                    POKERBOT_LOG(DEBUG) << "Call from small reraise from bb with bounty";
+                    return {Action::Type::CALL};
+                }
+                else
+                {
+                    POKERBOT_LOG(WARN) << "Error: Check after failed call from reraise otherwise";
+                    return {Action::Type::CHECK};
+                }
+            }
+            else
+            {
+                POKERBOT_LOG(DEBUG) << "Fold to reraise from bb with bounty";
+                return {Action::Type::FOLD};
+            }
+
+        }
+
+        if (((handStrength <= 8) && !oppReRaiseAsBBMore) ||
+            ((handStrength <= 9 || (handStrength <= 15 && oppPip <= 50)) && oppReRaiseAsBBMore)
+        ) //reraise without bounty or call big blind raises for more than 150
+        {
+            timesBetPreflop++;
+            myBet = 2 * pot;
+
+            if (legalActions.find(Action::Type::RAISE) != legalActions.end())
+            {
+                POKERBOT_LOG(DEBUG) << "2x reraise from raise";
+                return {Action::Type::RAISE, noIllegalRaises(myBet, roundState, active)};
+            }
+            else if (legalActions.find(Action::Type::CALL) != legalActions.end())
+            {
+                POKERBOT_LOG(DEBUG) << "Call after failed 2x reraise from raise";
+                return {Action::Type::CALL};
+            }
+            else
+            {
+                POKERBOT_LOG(WARN) << "Error: No legal actions found";
+            }
+        }
+        else if (oppPip <= 150 && handStrength <= (90 - pow((oppPip - 2) / 198.0, 1.0 / 3.0) * 90)) //call without bounty. TODO - change all in calling if opp is all-in bot
+        {
+            if (legalActions.find(Action::Type::CALL) != legalActions.end())
+            {
+                POKERBOT_LOG(DEBUG) << "Call from reraise otherwise";
+                return {Action::Type::CALL};
+            }
+            else
+            {
+                POKERBOT_LOG(WARN) << "Error: Check after failed call from reraise otherwise";
+                return {Action::Type::CHECK};
+            }
+        }
+        else //fold without bounty
+        {
+            POKERBOT_LOG(DEBUG) << "Fold to reraise from bb";
+            return {Action::Type::FOLD};
+        }
+    }
+    else  //any other situation after each team has acted once preflop
+    {
+        if (hasBounty) 
+        {
+            if (oldHandStrength <= 5) // reraise with bounty
+            {
+                timesBetPreflop++;
+                myBet = 2 * pot;
+                if (legalActions.find(Action::Type::RAISE) != legalActions.end())
+                {
+                    POKERBOT_LOG(DEBUG) << "2x reraise from raise with bounty";
+                    return {Action::Type::RAISE, noIllegalRaises(myBet, roundState, active)};
+                }
+                else if (legalActions.find(Action::Type::CALL) != legalActions.end())
+                {
+                    POKERBOT_LOG(DEBUG) << "Call after failed 2x reraise from raise with bounty";
+                    return {Action::Type::CALL};
+                }
+                else
+                {
+                    POKERBOT_LOG(WARN) << "Error: No legal actions found";
+                }
+            }
+            else if (continueCost <= 40 && oldHandStrength <= 87) //before we always call with top 110 here with bounty for <40, decreased a bit so we aren't calling behind as often. But potted in a lot
+            {
+                if (legalActions.find(Action::Type::CALL) != legalActions.end())
+                    {
+                        POKERBOT_LOG(DEBUG) << "WEEEWOOOWEEEWOOO Call huge raise with bounty";
+                        alarmBell = true;
+                        return {Action::Type::CALL};
+                    }
+                    else
+                    {
+                        POKERBOT_LOG(WARN) << "Error: Check after failed call from reraise otherwise";
+                        return {Action::Type::CHECK};
+                    }
+            }
+            else if (oldHandStrength <= (71 - pow((oppPip - 2) / 398.0, 1.0 / 3.0) * 61)) //call with bounty
+            {
+                if (legalActions.find(Action::Type::CALL) != legalActions.end())
+                {
+                    POKERBOT_LOG(DEBUG) << "WEEEWOOOWEEEWOOO Call from large reraise with bounty";
+                    alarmBell = true;
+                    return {Action::Type::CALL};
+                }
+                else
+                {
+                    POKERBOT_LOG(WARN) << "Error: Check after failed call from reraise otherwise";
+                    return {Action::Type::CHECK};
+                }
+            }
+            else
+            {
+                POKERBOT_LOG(DEBUG) << "Fold to reraise with bounty";
+                return {Action::Type::FOLD};
+            }
+
+        }
+
+        if (handStrength <= 5) //reraise without bounty
+        {
+            timesBetPreflop++;
+            myBet = 2 * pot;
+
+            if (legalActions.find(Action::Type::RAISE) != legalActions.end())
+            {
+                POKERBOT_LOG(DEBUG) << "2x reraise from raise";
+                return {Action::Type::RAISE, noIllegalRaises(myBet, roundState, active)};
+            }
+            else if (legalActions.find(Action::Type::CALL) != legalActions.end())
+            {
+                POKERBOT_LOG(DEBUG) << "Call after failed 2x reraise from raise";
+                return {Action::Type::CALL};
+            }
+            else
+            {
+                POKERBOT_LOG(WARN) << "Error:  legal actions found";
+            }
+        }
+        else if (handStrength <= (67 - pow((oppPip - 2) / 398.0, 1.0 / 3.0) * 61)) //call without bounty // TODO calling all ins?
+        {
+            if (legalActions.find(Action::Type::CALL) != legalActions.end())
+            {
+                POKERBOT_LOG(DEBUG) << "WEEEWOOOWEEEWOOO Call from reraise otherwise";
+                alarmBell = true;
+                return {Action::Type::CALL};
+            }
+            else
+            {
+                POKERBOT_LOG(WARN) << "Error: Check after failed call from reraise otherwise";
+                return {Action::Type::CHECK};
+            }
+        }
+        else //fold without bounty
+        {
+            POKERBOT_LOG(DEBUG) << "Fold to reraise from bb";
+            return {Action::Type::FOLD};
+        }
+    }
+    POKERBOT_LOG(WARN) << "Error: SHOULD NEVER BE HERE";
+    return {Action::Type::FOLD};
+}
+
+std::pair<Action, int> Bot::getPostflopAction(double handStrength, double rangeEquity, RoundStatePtr roundState, int active)
+{
+
+    /*
+    returns {action, then action type} pair
+    */
+    auto legalActions = roundState->legalActions();  // the actions you are allowed to take
+    int street = roundState->street; // 0, 3, 4, or 5 representing pre-flop, flop, turn, or river respectively
+    // auto myCards = roundState->hands[active];        // your cards
+    // auto boardCards = roundState->deck;              // the board cards
+    int myPip = roundState->pips[active];            // the number of chips you have contributed to the pot this round of betting
+    int oppPip = roundState->pips[1 - active];       // the number of chips your opponent has contributed to the pot this round of betting
+    int myStack = roundState->stacks[active];        // the number of chips you have remaining
+    int oppStack = roundState->stacks[1 - active];   // the number of chips your opponent has remaining
+    int continueCost = oppPip - myPip;               // the number of chips needed to stay in the pot
+    int myContribution = STARTING_STACK - myStack;   // the number of chips you have contributed to the pot
+    int oppContribution = STARTING_STACK - oppStack; // the number of chips your opponent has contributed to the pot
+    char myBounty = roundState->bounties[active];    // your current bounty rank
+    bool bigBlind = (active == 1);                   // true if you are the big blind
+
+    int pot = myContribution + oppContribution;
+
+    if (!nitToggle)
+    {
+        handStrength = pow(handStrength,1.2);
+        POKERBOT_LOG(DEBUG) << "NEW HAND STRENGTH: " << handStrength;
+    }
+    auto board = roundState->deck;
+
+    if (!hasBounty)
+    {
+        for (int i = 0; i < street; ++i)
+        {
+            const auto &card = board[i];
+            if (card.find(myBounty) != std::string::npos)
+            {
+                POKERBOT_LOG(DEBUG) << "Bounty is ACTIVE from board with bounty " << myBounty;
+                hasBounty = true;
+            }
+        }
+    }
+    // 1 with the bounty in hand, otherwise the exact chance the rest of the board brings it
+    std::array<int, 2> holeIndices = {cardIndex(roundState->hands[active][0]), cardIndex(roundState->hands[active][1])};
+    std::vector<int> boardIndices;
+    for (int i = 0; i < street; ++i)
+    {
+        boardIndices.push_back(cardIndex(board[i]));
+    }
+    double bountyOdds = bountyHitProbability(holeIndices, boardIndices, rankIndex(myBounty));
+
+    std::vector<Card> myCards;
+    for (const auto &cardStr : roundState->hands[active])
+    {
+        try
+        {
+            Card c(generateCardCodeFromString(cardStr));
+            myCards.emplace_back(c);
+            // std::cout << "My card: ";
+            // c.print();
+            // std::cout << std::endl;
+        }
+        catch (const std::exception &e)
+        {
+            POKERBOT_LOG(ERROR) << "Error converting my card: " << e.what();
+        }
+    }
+
+    std::vector<Card> boardCards;
+    for (int i = 0; i < street; ++i)
+    {
+        const auto &cardStr = roundState->deck[i];
+        try
+        {
+            Card c(generateCardCodeFromString(cardStr));
+            boardCards.emplace_back(c);
+            // std::cout << "Board card: ";
+            // c.print();
+            // std::cout << std::endl;
+        }
+        catch (const std::exception &e)
+        {
+            POKERBOT_LOG(ERROR) << "Error converting board card: " << e.what();
+        }
+    }
+
+    double randPercent = rng.uniform();
+
+    // if opponent bets
+    if (oppPip > 0)
+    {
+        oppLastContribution = oppContribution;
+        numOppChecks = 0;
+        oppNumBetsThisRound++;
+        if (myPip > 0)
+        {
+            oppNumReraise++;
+        }
+
+        POKERBOT_LOG(DEBUG) << "Opp bets";
+        oppBetLastRound = true;
+    }
+    else if (!bigBlind && oppPip == 0)
+    {
+        POKERBOT_LOG(DEBUG) << "Opp checks from bb";
+        numOppChecks++;
+    }
+    else if (bigBlind && street > 3 && oppContribution == oppLastContribution && !oppBetLastRound)
+    {
+        POKERBOT_LOG(DEBUG) << "Opp checks from prev street";
+        numOppChecks++;
+    }
+
+    if (legalActions.find(Action::Type::CHECK) != legalActions.end()) //Check or Raise
+    {
+        if (oppCheckFold && ourRaisesThisRound == 0 && oppNumBetsThisRound == 0)
+        {
+            POKERBOT_LOG(DEBUG) << "opp is cf bot";
+            if (hasBounty)
+            {
+                POKERBOT_LOG(DEBUG) << "min raise for cf";
+                return {{Action::Type::RAISE}, 6};
+            }
+            else if (street == 5)
+            {
+                POKERBOT_LOG(DEBUG) << "min raise for cf w no bounty";
+                return {{Action::Type::RAISE}, 6};
+            }
+            else
+            {
+                return {{Action::Type::CHECK}, -1};
+            }
+        }
+
+
+        oppBetLastRound = false;
+        POKERBOT_LOG(DEBUG) << "Able to check or out of position";
+
+        if (hasBounty && handStrength < 0.7 && (!permanentNoBountyBluff || (aggressiveMode && randPercent < 0.5)))
+        {
+            bountyRaises++;
+
+            if (bountyRaises > 1)
+            {
+                POKERBOT_LOG(DEBUG) << "I stop bounty bluff raising due to failed attempt";
+            }
+            else if (alarmBell)
+            {
+                POKERBOT_LOG(DEBUG) << "I stop bounty bluff raising due to alarm bell preflop";
+            }
+            else if (ourRaisesThisRound > 0)
+            {
+                POKERBOT_LOG(DEBUG) << "I stop bounty bluff raising due to us already raising this round";
+            }
+            else if (oppNumBetsThisRound > 1)
+            {
+                POKERBOT_LOG(DEBUG) << "I stop bounty bluff raising due to opp raising twice this round";
+            }
+            else if (street == 3 && handStrength > 0.65)
+            {
+                numOppChecks = 0;
+                numSelfChecks = 0;
+                ourRaisesThisRound++;
+                bountyBluff = true;
+                return {{Action::Type::RAISE}, 1};
+            }
+            else if (handStrength < 0.55 && ((randPercent < 0.60 && nitToggle) || aggressiveMode))
+            {
+                POKERBOT_LOG(DEBUG) << "I randomly bounty bluff raise #" << bountyRaises;
+                numOppChecks = 0;
+                numSelfChecks = 0;
+                ourRaisesThisRound++;
+                bountyBluff = true;
+                return {{Action::Type::RAISE}, 4};
+            }
+            else
+            {
+                POKERBOT_LOG(DEBUG) << "Randomly do not bluff raise bounty";
+            }
+        }
+
+        if (hasBounty && handStrength > 0.75)
+        {
+            POKERBOT_LOG(DEBUG) << "I try to value bounty raise";
+        }
+
+        double raiseStrength = 0.7 + ((street % 3) * (double)raiseFactor) + (double)ourRaisesThisRound*0.02 + (double)oppNumBetsThisRound * 0.02 + (double)oppNumReraise * 0.05;
+        raiseStrength = std::min(raiseStrength, 0.9);
+        POKERBOT_LOG(DEBUG) << "Raise Strength: " << raiseStrength;
+
+        double checkNutsStrength = 0.81 + (street % 3) * (double)reRaiseFactor;
+        double checkMegaNutsStrength = 0.87 + (street%3) * (double)reRaiseFactor;
+        double randPercent4 = rng.uniform();
+
+        if (!hasBounty && bigBlind && (bluffCatcherFact == 1 || (bluffCatcherFact == 0 && randPercent4 < 0.7)) && randPercent < 0.8 && handStrength > checkNutsStrength && (street == 3 || (street == 4 && oppNumBetsThisRound > 0 && ourRaisesThisRound < 1)))
+        {
+            POKERBOT_LOG(DEBUG) << "I check deception against agg team with strong hand";
+            numSelfChecks++;
+            return {{Action::Type::CHECK}, -1};
+        }
+
+        else if (!hasBounty && !bigBlind && (bluffCatcherFact == 1 || (bluffCatcherFact == 0 && randPercent4 < 0.6069)) && randPercent < 0.9 && handStrength > checkMegaNutsStrength && street == 3)
+        {
+            POKERBOT_LOG(DEBUG) << "I check deception against agg team with strong hand";
+            numSelfChecks++;
+            return {{Action::Type::CHECK}, -1};
+        }
+
+        else if (((randPercent < handStrength - 0.2 || street == 5)) && (handStrength >= raiseStrength))
+        {
+            numOppChecks = 0;
+            numSelfChecks = 0;
+            ourRaisesThisRound++;
+            //std::cout << "I random raise for value with handStrength " << handStrength << std::endl;
+            if (hasBounty)
+            {
+                return {{Action::Type::RAISE}, 8};
+            }
+            else
+            {
+                return {{Action::Type::RAISE}, 1};
+            }
+            
+        }
+        else if (alarmBell && numOppChecks >= 2)
+        {
+            POKERBOT_LOG(DEBUG) << "I stop two/three check bluff for alarm bell";
+            numSelfChecks++;
+            return {{Action::Type::CHECK}, -1};
+        }
+        else if (numOppChecks == 2 && !permanentNoTwoCheck && pot < 250 && nitToggle)
+        {
+            numOppChecks = 0;
+            numSelfChecks = 0;
+            ourRaisesThisRound++;
+            POKERBOT_LOG(DEBUG) << "I raise for 2 check bluff";
+            twoCheckBluff = true;
+            return {{Action::Type::RAISE}, 2};
+        }
+        else if (numOppChecks == 3 && !permanentNoThreeCheck && pot < 250)
+        {
+            numOppChecks = 0;
+            numSelfChecks = 0;
+            ourRaisesThisRound++;
+            POKERBOT_LOG(DEBUG) << "I raise for 3 check bluff";
+            threeCheckBluff = true;
+            return {{Action::Type::RAISE}, 3};
+        }
+
+        POKERBOT_LOG(DEBUG) << "I check";
+        numSelfChecks++;
+        return {{Action::Type::CHECK}, -1};
+    }
+    // opponent raises or reraises
+    else
+    {
+        POKERBOT_LOG(DEBUG) << "Opp raises/reraises";
+
+        double realPotOdds = (double)continueCost / (pot - continueCost); //percent of pot needed to call
+        POKERBOT_LOG(DEBUG) << "Real pot odds: " << realPotOdds;
+
+        // change pot odds
+
+        double changedPotOdds = realPotOdds;
+
+        if (realPotOdds > 1.7)
+        {
+            changedPotOdds = 0.82 + (street % 3)*0.02;
+            changedPotOdds += 0.04 * (double)oppNumReraise;
+            if (oppNumBetsThisRound > 2)
+            {
+                changedPotOdds += 0.03;
+            }
+            else if (ourRaisesThisRound >= 2 && myPip == 0 && street == 5)
+            {
+                changedPotOdds += 0.015;
+            }
+            changedPotOdds = std::min(0.86 + ((street % 3) * 0.01), changedPotOdds);
+        }
+        else if (realPotOdds > 1.1)
+        {
+            changedPotOdds = 0.77 + (street % 3)*0.02;
+            changedPotOdds += 0.06 * (double)oppNumReraise;
+            if (oppNumBetsThisRound > 2)
+            {
+                changedPotOdds += 0.04;
+            }
+            else if (ourRaisesThisRound >= 2 && myPip == 0 && street == 5)
+            {
+                changedPotOdds += 0.02;
+            }
+            changedPotOdds = std::min(0.86 + ((street % 3) * 0.01), changedPotOdds);
+        }
+        else if (realPotOdds > 0.8)
+        {
+            changedPotOdds = 0.695 + (street % 3)*0.03;
+            changedPotOdds += 0.135 * (double)oppNumReraise;
+            if (oppNumBetsThisRound > 2)
+            {
+                changedPotOdds += 0.11;
+            }
+            else if (ourRaisesThisRound >= 2 && myPip == 0 && street == 5)
+            {
+                changedPotOdds += 0.06;
+            }
+            changedPotOdds = std::min(0.85 + ((street % 3) * 0.01), changedPotOdds);
+        }
+        else if (realPotOdds > 0.7)
+        {
+            changedPotOdds = 0.645 + (street % 3)*0.03;
+            changedPotOdds += 0.18 * (double)oppNumReraise;
+            if (oppNumBetsThisRound > 2)
+            {
+                changedPotOdds += 0.14;
+            }
+            else if (ourRaisesThisRound >= 2 && myPip == 0 && street == 5)
+            {
+                changedPotOdds += 0.07;
+            }
+            changedPotOdds = std::min(0.83 + ((street % 3) * 0.02), changedPotOdds);
+        }
+        else
+        {
+            changedPotOdds = std::min(realPotOdds + 0.075, 0.645);
+            changedPotOdds += 0.19 * (double)oppNumReraise;
+            if (oppNumBetsThisRound > 2)
+            {
+                changedPotOdds += 0.19;
+            }
+            else if (ourRaisesThisRound >= 2 && myPip == 0 && street == 5)
+            {
+                changedPotOdds += 0.11;
+            }
+            changedPotOdds = std::min(0.82 + ((street % 3) * 0.02), changedPotOdds);
+        }
+
+        if (realPotOdds < 0.5)
+        {
+            changedPotOdds = std::min(realPotOdds + 0.125, 0.575);
+            changedPotOdds += 0.3 * (double)oppNumReraise;
+            if (oppNumBetsThisRound > 2)
+            {
+                changedPotOdds += 0.3;
+            }
+            else if (ourRaisesThisRound >= 2 && myPip == 0 && street == 5)
+            {
+                changedPotOdds += 0.175;
+            }
+            changedPotOdds = std::min(0.815 + ((street % 3) * 0.02), changedPotOdds);
+        }
+
+        else if (realPotOdds >= 1.1) 
+        {
+            if (oppNumReraise == 0 && oppNumBetsThisRound < 3)
+            {
+                changedPotOdds -= 0.06 * (double)unnitBigBetFact;
+            }
+            else
+            {
+                changedPotOdds -= 0.03 * (double)unnitBigBetFact;
+            }
+            
+        }
+
+        if (myPip == 0 && oppNumReraise == 0 && realPotOdds > 0.425 && realPotOdds < 1.4)
+        {
+            changedPotOdds -= (double)bluffCatcherFact * 0.1;
+        }
+        else if (myPip > 0 && realPotOdds > 0.375)
+        {
+            changedPotOdds -= (double)oppReraiseFact * 0.075;
+        }
+
+        if (bountyOdds > 0 && realPotOdds < 1.1 && oppNumReraise < 1 && oppNumBetsThisRound < 3)
+        {
+            changedPotOdds -= 0.05 * bountyOdds; //slight unnit with bounty to smaller bets (not reraises or continued betting from opponent), in proportion to the chance it hits by the river
+        }
+
+        if (aggressiveMode)
+        {
+            changedPotOdds -= 0.075;
+        }
+
+        POKERBOT_LOG(DEBUG) << "Changed pot odds: " << changedPotOdds;
+
+        if (handStrength < changedPotOdds) // TODO FIX CALLING LOOSE/NIT
+        {
+            // TODO MAYBE ADD FLOATING ON THE FLOP?
+            return {{Action::Type::FOLD}, -1};
+        }
+        else if (changedPotOdds >= 0.2 && (handStrength < 0.35 + (street%3)*.1)) //only auto fold shitters to decent sized bets
+        {
+            return {{Action::Type::FOLD}, -1};
+        }
+        else
+        {
+            double reraiseStrength = (0.81 + ((street % 3) * (double)reRaiseFactor));
+            reraiseStrength += oppNumReraise * 0.05; // increase reraise strength if opponent reraises
+            reraiseStrength += ourReRaisesThisRound * 0.04;
+
+            if (reraiseLess)
+            {
+                reraiseStrength += 0.05 - (street % 3) * 0.01;
+                POKERBOT_LOG(DEBUG) << "rr less";
+            }
+            
+            if (realPotOdds > 1.1) //more nitty reraising against huge opponent bets
+            {
+                reraiseStrength += 0.01 * (2 - unnitBigBetFact);
+            }
+            if (reraiseStrength > 0.94) // more nitty cap against reraising
+            {
+                reraiseStrength = 0.94;
+            }
+            double randPercent3 = rng.uniform();
+            double theNutsStrength = 0.85 + .02 * (street % 3);
+
+            // a value reraise has to be ahead of the hands that make this bet, not just of a random hand
+            bool aheadOfBettors = rangeEquity < 0 || rangeEquity >= 0.5;
+            if (aheadOfBettors && (handStrength >= reraiseStrength || (handStrength - changedPotOdds > 0.5 && handStrength >= reraiseStrength - 0.05)))
+            {
+                if (handStrength > theNutsStrength && (street == 3 || (street == 4 && randPercent3 < 0.75 && bluffCatcherFact == 1)))
+                {
+                    double randPercent2 = rng.uniform();
+                    if (!hasBounty && pot < 100 && (randPercent2 < 0.5 || (randPercent2 < 0.85 && bluffCatcherFact == 1)))
+                    {
+                        POKERBOT_LOG(DEBUG) << "I call with nuts deception";
+                        return {{Action::Type::CALL}, -1};
+                    }
+                }
+                // call, min-click or pot reraise, whichever is worth most on this decision's samples
+                int minRaise = roundState->raiseBounds()[0];
+                int potRaise = noIllegalRaises(oppPip + pot + continueCost, roundState, active);
+                int choice = bestAmount(roundState, active, {oppPip, minRaise, potRaise});
+                if (choice == oppPip)
+                {
+                    POKERBOT_LOG(DEBUG) << "I call rather than reraise";
+                    return {{Action::Type::CALL}, -1};
+                }
+                numOppChecks = 0;
+                numSelfChecks = 0;
+                ourRaisesThisRound++;
+                ourReRaisesThisRound++;
+                if (choice == minRaise)
+                {
+                    POKERBOT_LOG(DEBUG) << "I min-click reraise for max value";
+                    return {{Action::Type::RAISE}, 6};
+                }
+                POKERBOT_LOG(DEBUG) << "I reraise to " << choice;
+                return {{Action::Type::RAISE, choice}, 5};
+            }
+        }
+        POKERBOT_LOG(DEBUG) << "I call";
+        return {{Action::Type::CALL}, -1};
+    }
+}
+
+Candidate Bot::candidateAt(RoundStatePtr roundState, int active, int amount)
+{
+    double ours = STARTING_STACK - roundState->stacks[active];
+    double theirs = STARTING_STACK - roundState->stacks[1 - active];
+    double to = ours - roundState->pips[active] + amount;
+    double continuing = to > theirs ? ActionSamples::defendingShare(2 * theirs, to - theirs) : 1.0;
+    return {ours, theirs, to, continuing};
+}
+
+int Bot::bestAmount(RoundStatePtr roundState, int active, const std::vector<int> &amounts)
+{
+    if (actionSamples.empty())
+    {
+        return amounts.front();
+    }
+    std::size_t best = 0;
+    std::vector<Candidate> candidates;
+    std::vector<Estimate> values;
+    for (std::size_t i = 0; i < amounts.size(); ++i)
+    {
+        candidates.push_back(candidateAt(roundState, active, amounts[i]));
+        values.push_back(actionSamples.value(candidates.back()));
+        if (values[i].mean > values[best].mean)
+        {
+            best = i;
+        }
+    }
+    for (std::size_t i = 0; i < amounts.size(); ++i)
+    {
+        if (amounts[i] != amounts[best])
+        {
+            // the paired error is what common samples buy over two independent estimates
+            auto gap = actionSamples.difference(candidates[best], candidates[i]);
+            double independent = std::hypot(values[best].standardError, values[i].standardError);
+            POKERBOT_LOG(DEBUG) << "Amount " << amounts[best] << " beats " << amounts[i] << " by " << gap.mean << " +- " << gap.standardError << " (independent +- " << independent << ")";
+        }
+    }
+    return amounts[best];
+}
+
+int Bot::bestRangeAmount(RoundStatePtr roundState, int active, const std::vector<int> &amounts, const Range &villainRange)
+{
+    std::array<int, 2> hole = {cardIndex(roundState->hands[active][0]), cardIndex(roundState->hands[active][1])};
+    std::vector<int> board;
+    for (int i = 0; i < roundState->street; ++i)
+    {
+        board.push_back(cardIndex(roundState->deck[i]));
+    }
+    Range villain = villainRange;
+    for (int combo = 0; combo < NUM_COMBOS; ++combo)
+    {
+        if (comboSet(combo).intersects(CardSet{hole[0], hole[1]}))
+        {
+            villain[combo] = 0.0f;
+        }
+    }
+    Range everyone;
+    everyone.fill(1.0f);
+    Range hand{};
+    hand[comboIndex(hole[0], hole[1])] = 1.0f;
+    auto againstRandom = computeRangeEquity(board, everyone, villain, false);
+    auto againstUs = computeRangeEquity(board, hand, villain, false);
+
+    int bountyRank = rankIndex(roundState->bounties[active]);
+    double hit = bountyHitProbability(hole, board, bountyRank);
+    auto winning = [&](double stake) { return stake + hit * (stake * (BOUNTY_RATIO - 1) + BOUNTY_CONSTANT); };
+    std::size_t best = 0;
+    std::vector<double> values;
+    for (int amount : amounts)
+    {
+        Candidate candidate = candidateAt(roundState, active, amount);
+        double price = (candidate.to - candidate.theirs) / (2 * candidate.to);
+        double folds = hit == 1 ? candidate.theirs * BOUNTY_RATIO + BOUNTY_CONSTANT : candidate.theirs;
+        double total = 0;
+        double value = 0;
+        for (int combo : againstUs.combosB)
+        {
+            double weight = villain[combo];
+            total += weight;
+            double theirs = againstUs.equityB[combo];
+            value += weight * (againstRandom.equityB[combo] < price ? folds : (1 - theirs) * winning(candidate.to) - theirs * candidate.to);
+        }
+        values.push_back(total > 0 ? value / total : 0);
+        if (values.back() > values[best])
+        {
+            best = values.size() - 1;
+        }
+    }
+    POKERBOT_LOG(DEBUG) << "Against the range, raising to " << amounts[best] << " is worth " << values[best];
+    return amounts[best];
+}
+
+int Bot::bestRaiseSize(RoundStatePtr roundState, int active, int pot, double low, double high, const Range *villainRange)
+{
+    std::vector<int> amounts;
+    for (double fraction : {low, (low + high) / 2, high})
+    {
+        amounts.push_back(noIllegalRaises(int(fraction * pot), roundState, active));
+    }
+    if (villainRange)
+    {
+        return bestRangeAmount(roundState, active, amounts, *villainRange);
+    }
+    return bestAmount(roundState, active, amounts);
+}
+
+bool Bot::estimateVillainRange(RoundStatePtr roundState, int active, Range &range)
+{
+    range.fill(1.0f);
+    int myPip = roundState->pips[active];
+    int oppPip = roundState->pips[1 - active];
+    if (!(oppPip > myPip || (active == 0 && oppPip == 0)))
+    {
+        return false;
+    }
+    int continueCost = oppPip - myPip;
+    int pot = 2 * STARTING_STACK - roundState->stacks[0] - roundState->stacks[1];
+    std::vector<int> board;
+    for (int i = 0; i < roundState->street; ++i)
+    {
+        board.push_back(cardIndex(roundState->deck[i]));
+    }
+    return opponentModel.narrowRange(range, board, static_cast<double>(continueCost) / (pot - continueCost));
+}
+
+double Bot::decisionSeconds(GameInfoPtr gameState)
+{
+    int roundsLeft = std::max(1, NUM_ROUNDS - gameState->roundNum + 1);
+    return std::min(maxResolveSeconds, resolveClockShare * gameState->gameClock / roundsLeft);
+}
+
+std::optional<int> Bot::getResolvedBetSize(RoundStatePtr roundState, int active, const Range &villainRange, double seconds)
+{
+    // our range stays every combo the board allows, the opponent's is what their showdowns say this check or bet holds
+    SubgameSpot spot{roundState, active, {cardIndex(roundState->hands[active][0]), cardIndex(roundState->hands[active][1])}, rankIndex(roundState->bounties[active]), {}, villainRange};
+    spot.heroRange.fill(1.0f);
+    ResolveOptions options;
+    options.seconds = seconds;
+    if (fixedResolveIterations > 0)
+    {
+        options.seconds = std::numeric_limits<double>::infinity();
+        options.maxIterations = fixedResolveIterations;
+    }
+    ResolveResult result = resolveSubgame(spot, workers, options);
+
+    double raiseTotal = 0;
+    for (size_t a = 0; a < result.actions.size(); ++a)
+    {
+        if (result.actions[a].actionType == Action::Type::RAISE)
+        {
+            raiseTotal += result.strategy[a];
+        }
+    }
+    POKERBOT_LOG(DEBUG) << "Resolved: " << result.iterations << " iterations, raise " << raiseTotal;
+    if (result.iterations < minResolveIterations || raiseTotal < 1e-3)
+    {
+        return std::nullopt;
+    }
+    double target = rng.uniform() * raiseTotal;
+    for (size_t a = 0; a < result.actions.size(); ++a)
+    {
+        if (result.actions[a].actionType != Action::Type::RAISE)
+        {
+            continue;
+        }
+        target -= result.strategy[a];
+        if (target <= 0)
+        {
+            return noIllegalRaises(result.actions[a].amount, roundState, active);
+        }
+    }
+    return noIllegalRaises(result.actions.back().amount, roundState, active);
+}
+
+int Bot::getPostflopBetSize(double handStrength, GameInfoPtr gameState, RoundStatePtr roundState, int active, int actionCategory)
+{
+    // 1 is value, 2 is 2 check bluff, 3 is 3 check bluff
+
+    auto legalActions =
+        roundState->legalActions();  // the actions you are allowed to take
+    int street = roundState->street; // 0, 3, 4, or 5 representing pre-flop, flop, turn, or river respectively
+    // auto myCards = roundState->hands[active];        // your cards
+    int oppPip = roundState->pips[1 - active];       // the number of chips your opponent has contributed to the pot this round of betting
+    int myStack = roundState->stacks[active];        // the number of chips you have remaining
+    int oppStack = roundState->stacks[1 - active];   // the number of chips your opponent has remaining
+    int myContribution = STARTING_STACK - myStack;   // the number of chips you have contributed to the pot
+    int oppContribution = STARTING_STACK - oppStack; // the number of chips your opponent has contributed to the pot
+    char myBounty = roundState->bounties[active];    // your current bounty rank
+    bool bigBlind = (active == 1);                   // true if you are the big blind
+
+    int pot = myContribution + oppContribution;
+
+    double randPercent = rng.uniform();
+
+    double nutsThreshold = 0.86 + 0.02 * (street % 3); //nutted
+    double secondThreshold = 0.80 + 0.03 * (street % 3);
+
+    // on the turn and river the size comes from re-solving the spot; the min click stays a deliberate choice
+    auto start = std::chrono::steady_clock::now();
+    double seconds = decisionSeconds(gameState);
+    Range villainRange;
+    villainRange.fill(1.0f);
+    bool narrowed = false;
+    if (street >= 4 && actionCategory != 6 && seconds >= minResolveSeconds)
+    {
+        // one estimate per decision, for the resolver and the range sizing below alike
+        narrowed = estimateVillainRange(roundState, active, villainRange);
+    }
+    // without that estimate the spot is uniform against uniform, which nobody is in, so keep the fixed sizes
+    if (narrowed)
+    {
+        POKERBOT_LOG(DEBUG) << "Villain range narrowed from showdowns";
+        if (auto resolvedSize = getResolvedBetSize(roundState, active, villainRange, seconds))
+        {
+            return *resolvedSize;
+        }
+    }
+    // sizing against the range only while what is left of this decision's share of the clock covers it
+    double spent = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const Range *sizingRange = street >= 4 && seconds - spent >= rangeSizingSeconds ? &villainRange : nullptr;
+
+    // bluffing raise
+    if (actionCategory == 4 || actionCategory == 3 || actionCategory == 2)
+    {
+        return noIllegalRaises(int((std::max(randPercent + 0.35, 1.1)) * pot), roundState, active); //1.1 - 1.55x pot for bluff
+    }
+    // value raise; reraises (5) come with their amount and never get here
+    else if (actionCategory == 6) //min click reraise
+    {
+        return noIllegalRaises(1, roundState, active); //reraises
+    }
+    else if (actionCategory == 8 && handStrength >= nutsThreshold)
+    {
+        if (pot >= 20 && street != 5)
+        {
+            return bestRaiseSize(roundState, active, pot, 0.4, 0.6, sizingRange); //try potting opponent in with the nuts early in hand
+        }
+        else
+        {
+            return bestRaiseSize(roundState, active, pot, 0.5, 0.8, sizingRange); // 1.2-1.85x pot
+        }
+    }
+    else if (actionCategory == 1 && handStrength >= nutsThreshold)
+    {
+        if (pot >= 20 && street != 5)
+        {
+            return bestRaiseSize(roundState, active, pot, 0.5, 0.75, sizingRange); //try potting opponent in with the nuts early in hand
+        }
+        else
+        {
+            return bestRaiseSize(roundState, active, pot, 0.75, 1.2, sizingRange); // 1.2-1.85x pot
+        }
+    } 
+    else
+    {
+        return bestRaiseSize(roundState, active, pot, 0.5, 1.5, sizingRange); //0.5-1.5x pot for value
+    }
+}
+
+bool Bot::handleIdle(GameInfoPtr, RoundStatePtr roundState, int active)
+{
+    if (alreadyWon || autoFold)
+    {
+        return false;
+    }
+    std::array<int, 2> myCards = {cardIndex(roundState->hands[active][0]), cardIndex(roundState->hands[active][1])};
+    std::vector<int> boardCards;
+    // a call that closes the street has moved the state on before the next card is known
+    for (int i = 0; i < 5 && cardIndex(roundState->deck[i]) >= 0; ++i)
+    {
+        boardCards.push_back(cardIndex(roundState->deck[i]));
+    }
+    // every flop is too many to cover, and the river is analysed exactly
+    if (boardCards.size() < 3 || boardCards.size() == 5)
+    {
+        return false;
+    }
+    int bountyRank = rankIndex(roundState->bounties[active]);
+    if (featureMemo.prepare(myCards, boardCards, bountyRank))
+    {
+        return true;
+    }
+    if (boardCards.size() == 4)
+    {
+        return false;
+    }
+    CardSet live = CardSet::deck() - CardSet::of(boardCards) - CardSet::of(myCards);
+    boardCards.push_back(0);
+    for (int card : live)
+    {
+        boardCards.back() = card;
+        if (featureMemo.prepare(myCards, boardCards, bountyRank))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::optional<Action> Bot::getBlueprintAction(RoundStatePtr roundState, int active)
+{
+    if (strategyTable.empty())
+    {
+        return std::nullopt;
+    }
+    const GameTree &tree = strategyTable.tree();
+    // only the actions since our last decision are translated
+    int node = blueprintCursor->sync(roundState);
+    int street = roundState->street;
+    if (node < 0 || strategyCards->numBuckets(street) != strategyTable.buckets()[streetSlot(street)])
+    {
+        return std::nullopt;
+    }
+
+    std::array<int, 2> myCards = {cardIndex(roundState->hands[active][0]), cardIndex(roundState->hands[active][1])};
+    std::vector<int> boardCards;
+    int bountyRank = rankIndex(roundState->bounties[active]);
+    bool bountyHit = rankOf(myCards[0]) == bountyRank || rankOf(myCards[1]) == bountyRank;
+    for (int i = 0; i < street; ++i)
+    {
+        boardCards.push_back(cardIndex(roundState->deck[i]));
+        bountyHit = bountyHit || rankOf(boardCards.back()) == bountyRank;
+    }
+    int bucket = strategyCards->bucket(myCards, boardCards, rng);
+    int uniform = static_cast<int>(rng.below(QUANTIZED_TOTAL));
+    Action choice = tree.action(node, strategyTable.sample(node, bucket, bountyHit, uniform));
+    POKERBOT_LOG(DEBUG) << "Blueprint: node " << node << " bucket " << bucket << " action " << static_cast<int>(choice.actionType) << " " << choice.amount;
+
+    // the abstract tree can drift from the real stacks, so map the choice onto what is legal now
+    auto legalActions = roundState->legalActions();
+    if (choice.actionType == Action::Type::RAISE && legalActions.count(Action::Type::RAISE))
+    {
+        auto bounds = roundState->raiseBounds();
+        return Action{Action::Type::RAISE, std::clamp(choice.amount, bounds[0], bounds[1])};
+    }
+    if (choice.actionType == Action::Type::FOLD && legalActions.count(Action::Type::FOLD))
+    {
+        return Action{Action::Type::FOLD};
+    }
+    return legalActions.count(Action::Type::CALL) ? Action{Action::Type::CALL} : Action{Action::Type::CHECK};
+}
+
+Action Bot::getAction(GameInfoPtr gameState, RoundStatePtr roundState, int active)
+{
+    if (alreadyWon || autoFold)
+    {
+        return {Action::Type::FOLD};
+    }
+    // the hand-tuned path runs either way, since it keeps the opponent reads and bluff state up to date
+    Action action = getHandTunedAction(gameState, roundState, active);
+    if (auto blueprintAction = getBlueprintAction(roundState, active))
+    {
+        return *blueprintAction;
+    }
+    return action;
+}
+
+Action Bot::getHandTunedAction(GameInfoPtr gameState, RoundStatePtr roundState, int active)
+{
+    auto legalActions =
+        roundState->legalActions();  // the actions you are allowed to take
+    int street = roundState->street; // 0, 3, 4, or 5 representing pre-flop, flop, turn, or river respectively
+    // auto myCards = roundState->hands[active];        // your cards
+    // auto boardCards = roundState->deck;              // the board cards
+    int myPip = roundState->pips[active];            // the number of chips you have contributed to the pot this round of betting
+    int oppPip = roundState->pips[1 - active];       // the number of chips your opponent has contributed to the pot this round of betting
+    int myStack = roundState->stacks[active];        // the number of chips you have remaining
+    int oppStack = roundState->stacks[1 - active];   // the number of chips your opponent has remaining
+    int continueCost = oppPip - myPip;               // the number of chips needed to stay in the pot
+    int myContribution = STARTING_STACK - myStack;   // the number of chips you have contributed to the pot
+    int oppContribution = STARTING_STACK - oppStack; // the number of chips your opponent has contributed to the pot
+    char myBounty = roundState->bounties[active];    // your current bounty rank
+
+    double handStrength;
+    double rangeEquity = -1; // against the range that makes the bet we face, when the opponent model has one
+
+    std::pair<Action, int> postflopAction;
+
+    if (street == 0)
+    {
+        return getPreflopAction(roundState, active);
+    }
+    else
+    {
+
+        if (street == 3)
+        {
+            oppLastContribution = oppContribution;
+        }
+
+        std::array<int, 2> myCards;
+        for (int i = 0; i < 2; ++i)
+        {
+            myCards[i] = cardIndex(roundState->hands[active][i]);
+        }
+
+        std::vector<int> boardCards;
+        for (int i = 0; i < street; ++i)
+        {
+            boardCards.push_back(cardIndex(roundState->deck[i]));
+        }
+
+        if (street == 5)
+        {
+            // nothing is left to deal, so every opponent combo is scored exactly in less time than sampling took
+            RiverAnalysis river(myCards, boardCards);
+            // ties count as wins in handStrength, as the thresholds expect
+            handStrength = river.notBehind();
+            handFeatures = HandFeatures{};
+            handFeatures.equity = handFeatures.handStrength = handFeatures.ehs = river.percentile();
+            handFeatures.notBehind = handStrength;
+            handFeatures.ehs2 = handFeatures.equity * handFeatures.equity;
+            handFeatures.bountyHit = bountyHitProbability(myCards, boardCards, rankIndex(myBounty));
+            (handFeatures.bountyHit > 0 ? handFeatures.equityIfHit : handFeatures.equityIfMiss) = handFeatures.equity;
+            POKERBOT_LOG(DEBUG) << "River rank " << river.rank() << " of " << river.combos() + 1 << ": " << handStrength;
+
+            int continueCost = roundState->pips[1 - active] - roundState->pips[active];
+            int pot = 2 * STARTING_STACK - roundState->stacks[0] - roundState->stacks[1];
+            Range villainRange;
+            villainRange.fill(1.0f);
+            if (continueCost > 0 && opponentModel.narrowRange(villainRange, boardCards, static_cast<double>(continueCost) / (pot - continueCost)))
+            {
+                // the thresholds already scale with the bet, so this only decides whether a reraise is still value
+                auto share = river.against(villainRange);
+                rangeEquity = share.equity();
+                POKERBOT_LOG(DEBUG) << "Against the range that bets this: win " << share.win << " | tie " << share.tie << " -> " << rangeEquity;
+            }
+        }
+        else
+        {
+            // same number of opponent hands per batch as the old MC loop, with our own hand scored once per runout
+            const FeatureCounts &counts = featureMemo.refine(myCards, boardCards, rankIndex(myBounty));
+            handFeatures = counts.finish();
+            // the hit itself needs no sampling, only the equity that goes with it
+            handFeatures.bountyHit = bountyHitProbability(myCards, boardCards, rankIndex(myBounty));
+            handStrength = handFeatures.notBehind;
+            POKERBOT_LOG(DEBUG) << "MC Simulation: " << handStrength << " for street " << street << " over " << counts.runouts << " runouts";
+        }
+        // one sample set per decision, shared by every action and size compared below
+        actionSamples = ActionSamples(myCards, boardCards, rankIndex(myBounty), numMCTrials / oppHandsPerRunout, oppHandsPerRunout, rng);
+        POKERBOT_LOG(DEBUG) << "EHS: " << handFeatures.ehs << " | EHS2: " << handFeatures.ehs2 << " | PPot: " << handFeatures.ppot << " | NPot: " << handFeatures.npot << " | Bounty: " << handFeatures.bountyHit << " (equity " << handFeatures.equityIfHit << " if it hits, " << handFeatures.equityIfMiss << " if not)";
+
+        postflopAction = getPostflopAction(handStrength, rangeEquity, roundState, active);
+    }
+
+    auto actionPostflop = postflopAction.first;
+    auto actionCategory = postflopAction.second;
+
+    if (actionCategory == -1)
+    {
+        return actionPostflop;
+    }
+    else
+    {
+        // TRY TO RAISE
+        if (legalActions.find(Action::Type::RAISE) != legalActions.end())
+        {
+            // a reraise already carries the amount it was compared at
+            int amount = actionPostflop.amount > 0 ? actionPostflop.amount : getPostflopBetSize(handStrength, gameState, roundState, active, actionCategory);
+            return {Action::Type::RAISE, amount};
+        }
+        else if (legalActions.find(Action::Type::CALL) != legalActions.end())
+        {
+            POKERBOT_LOG(DEBUG) << "Call after failed reraise";
+            return {Action::Type::CALL};
+        }
+        else
+        {
+            numSelfChecks++;
+            if (twoCheckBluff)
+            {
+                POKERBOT_LOG(DEBUG) << "Not actual two check bluff";
+                twoCheckBluff = false;
+            }
+            if (threeCheckBluff)
+            {
+                POKERBOT_LOG(DEBUG) << "Not actual three check bluff";
+                threeCheckBluff = false;
+            }
+            if (bountyBluff)
+            {
+                POKERBOT_LOG(DEBUG) << "Not actual bounty bluff";
+                bountyBluff = false;
+            }
+            POKERBOT_LOG(DEBUG) << "Check after failed call and reraise";
+            return {Action::Type::CHECK};
+        }
+    }
+}
@@ -0,0 +1,294 @@
+/*
+  Offline card abstraction generator.
+
+  For each street it collects canonical (hole cards, board) situations, samples an
+  equity histogram for each one, clusters the histograms with k-means under earth
+  mover's distance and writes every situation's bucket plus the centroids as a
+  BucketTable. The bot loads the table at startup.
+
+  Usage:
+    bucketer [--out data/buckets.bin] [--buckets 169,200,200,200] [--bins 30]
+             [--runouts 64] [--opponents 16] [--situations 0,0,200000,200000]
+             [--iterations 25] [--threads 0] [--seed 1]
+
+  Comma separated values are per street (preflop, flop, turn, river). A situation
+  count of 0 enumerates the whole street, which is only practical preflop (169)
+  and on the flop (about 1.3 million).
+*/
+#include <skeleton/buckets.h>
+#include <skeleton/equity.h>
+#include <skeleton/thread_pool.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace pokerbots::skeleton;
+
+namespace {
+
+constexpr int STREETS[4] = {0, 3, 4, 5};
+
+struct Options {
+  std::string out = "data/buckets.bin";
+  std::array<int, 4> buckets = {169, 200, 200, 200};
+  std::array<int, 4> situations = {0, 0, 200000, 200000};
+  int bins = 30;
+  int runouts = 64;
+  int opponents = 16;
+  int iterations = 25;
+  unsigned threads = 0;
+  unsigned seed = 1;
+};
+
+std::array<int, 4> parseList(const std::string &arg) {
+  std::array<int, 4> values{};
+  std::stringstream ss(arg);
+  std::string item;
+  for (int i = 0; i < 4 && std::getline(ss, item, ','); ++i) {
+    values[i] = std::stoi(item);
+  }
+  return values;
+}
+
+Options parseOptions(int argc, char *argv[]) {
+  Options options;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag(argv[i]);
+    std::string value(argv[i + 1]);
+    if (flag == "--out") {
+      options.out = value;
+    } else if (flag == "--buckets") {
+      options.buckets = parseList(value);
+    } else if (flag == "--situations") {
+      options.situations = parseList(value);
+    } else if (flag == "--bins") {
+      options.bins = std::stoi(value);
+    } else if (flag == "--runouts") {
+      options.runouts = std::stoi(value);
+    } else if (flag == "--opponents") {
+      options.opponents = std::stoi(value);
+    } else if (flag == "--iterations") {
+      options.iterations = std::stoi(value);
+    } else if (flag == "--threads") {
+      options.threads = std::stoul(value);
+    } else if (flag == "--seed") {
+      options.seed = std::stoul(value);
+    } else {
+      std::cerr << "Unknown option " << flag << std::endl;
+    }
+  }
+  return options;
+}
+
+// Inverse of canonicalSituation: the packed cards are already a valid situation.
+void decodeSituation(std::uint64_t key, int boardSize, std::array<int, 2> &hole,
+                     std::vector<int> &board) {
+  int cards[7];
+  for (int i = 6; i >= 0; --i) {
+    cards[i] = static_cast<int>(key & 63);
+    key >>= 6;
+  }
+  hole = {cards[0], cards[1]};
+  board.assign(cards + 2, cards + 2 + boardSize);
+}
+
+std::vector<std::uint64_t> enumerateSituations(int street, ThreadPool &pool) {
+  std::vector<std::uint64_t> keys;
+  if (street == 0) {
+    for (const auto &combo : COMBO_CARDS) {
+      keys.push_back(canonicalSituation({combo.first, combo.second}, {}));
+    }
+  } else {
+    // every situation is isomorphic to one whose hole cards are a canonical
+    // preflop representative, so only those need their flops enumerated
+    std::vector<std::uint64_t> holes;
+    for (const auto &combo : COMBO_CARDS) {
+      holes.push_back(canonicalSituation({combo.first, combo.second}, {}));
+    }
+    std::sort(holes.begin(), holes.end());
+    holes.erase(std::unique(holes.begin(), holes.end()), holes.end());
+
+    std::vector<std::vector<std::uint64_t>> found(pool.size());
+    pool.parallelFor(holes.size(), [&](std::size_t i, unsigned worker) {
+      std::array<int, 2> hole;
+      std::vector<int> unused;
+      decodeSituation(holes[i], 0, hole, unused);
+      for (int a = 0; a < NUM_CARDS; ++a) {
+        for (int b = a + 1; b < NUM_CARDS; ++b) {
+          for (int c = b + 1; c < NUM_CARDS; ++c) {
+            if (a == hole[0] || a == hole[1] || b == hole[0] || b == hole[1] ||
+                c == hole[0] || c == hole[1]) {
+              continue;
+            }
+            found[worker].push_back(canonicalSituation(hole, {a, b, c}));
+          }
+        }
+      }
+    });
+    for (auto &part : found) {
+      keys.insert(keys.end(), part.begin(), part.end());
+    }
+  }
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  return keys;
+}
+
+std::vector<std::uint64_t> sampleSituations(int street, int count, Rng &rng) {
+  std::unordered_set<std::uint64_t> keys;
+  std::vector<int> deck(NUM_CARDS);
+  for (int card = 0; card < NUM_CARDS; ++card) {
+    deck[card] = card;
+  }
+  // give up after a generous number of duplicates on small streets
+  for (long attempt = 0; static_cast<int>(keys.size()) < count && attempt < 20L * count; ++attempt) {
+    for (int i = 0; i < 2 + street; ++i) {
+      std::swap(deck[i], deck[rng.between(i, NUM_CARDS - 1)]);
+    }
+    keys.insert(canonicalSituation({deck[0], deck[1]},
+                                   std::vector<int>(deck.begin() + 2, deck.begin() + 2 + street)));
+  }
+  std::vector<std::uint64_t> sorted(keys.begin(), keys.end());
+  std::sort(sorted.begin(), sorted.end());
+  return sorted;
+}
+
+// k-means under EMD; centroids are member means, seeded with k-means++.
+void cluster(const std::vector<float> &histograms, StreetBuckets &street, int iterations,
+             ThreadPool &pool, Rng &rng) {
+  int bins = street.bins;
+  std::size_t points = histograms.size() / bins;
+  int k = static_cast<int>(std::min<std::size_t>(street.buckets, points));
+  street.buckets = k;
+  street.centroids.assign(static_cast<std::size_t>(k) * bins, 0.0f);
+  street.assignment.assign(points, 0);
+  auto point = [&](std::size_t i) { return &histograms[i * bins]; };
+
+  std::vector<float> distance(points, std::numeric_limits<float>::max());
+  std::size_t first = rng.below(static_cast<std::uint32_t>(points));
+  std::copy(point(first), point(first) + bins, street.centroids.begin());
+  for (int c = 1; c <= k; ++c) {
+    const float *latest = &street.centroids[(c - 1) * bins];
+    pool.parallelFor(points, [&](std::size_t i, unsigned) {
+      distance[i] = std::min(distance[i], earthMoversDistance(point(i), latest, bins));
+    });
+    if (c == k) {
+      break;
+    }
+    double total = 0;
+    for (auto d : distance) {
+      total += static_cast<double>(d) * d;
+    }
+    double remaining = rng.uniform() * total;
+    std::size_t chosen = 0;
+    for (; chosen + 1 < points; ++chosen) {
+      remaining -= static_cast<double>(distance[chosen]) * distance[chosen];
+      if (remaining <= 0) {
+        break;
+      }
+    }
+    std::copy(point(chosen), point(chosen) + bins, street.centroids.begin() + c * bins);
+  }
+
+  for (int iteration = 0; iteration < iterations; ++iteration) {
+    std::vector<std::size_t> changed(pool.size(), 0);
+    pool.parallelFor(points, [&](std::size_t i, unsigned worker) {
+      auto nearest = static_cast<std::uint16_t>(street.nearest(point(i)));
+      changed[worker] += nearest != street.assignment[i];
+      street.assignment[i] = nearest;
+    });
+
+    std::vector<double> sums(static_cast<std::size_t>(k) * bins, 0.0);
+    std::vector<std::size_t> sizes(k, 0);
+    for (std::size_t i = 0; i < points; ++i) {
+      auto c = street.assignment[i];
+      ++sizes[c];
+      for (int b = 0; b < bins; ++b) {
+        sums[c * bins + b] += point(i)[b];
+      }
+    }
+    for (int c = 0; c < k; ++c) {
+      // an emptied cluster keeps its old centroid
+      for (int b = 0; sizes[c] > 0 && b < bins; ++b) {
+        street.centroids[c * bins + b] = static_cast<float>(sums[c * bins + b] / sizes[c]);
+      }
+    }
+
+    std::size_t moves = 0;
+    for (auto m : changed) {
+      moves += m;
+    }
+    std::cout << "  iteration " << iteration << ": " << moves << " reassigned" << std::endl;
+    if (iteration > 0 && moves == 0) {
+      break;
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  auto options = parseOptions(argc, argv);
+  ThreadPool pool(options.threads);
+  Rng rng(options.seed);
+  BucketTable table;
+
+  for (int slot = 0; slot < 4; ++slot) {
+    int street = STREETS[slot];
+    if (options.buckets[slot] <= 0) {
+      continue;
+    }
+    if (street > 3 && options.situations[slot] <= 0) {
+      std::cerr << "street " << street << " is too large to enumerate, pass a situation count"
+                << std::endl;
+      continue;
+    }
+    auto start = std::chrono::steady_clock::now();
+    auto keys = options.situations[slot] > 0 ? sampleSituations(street, options.situations[slot], rng)
+                                             : enumerateSituations(street, pool);
+    std::cout << "street " << street << ": " << keys.size() << " situations" << std::endl;
+
+    std::vector<float> histograms(keys.size() * options.bins);
+    std::vector<Rng> workerRngs;
+    for (unsigned w = 0; w < pool.size(); ++w) {
+      workerRngs.push_back(Rng::stream(options.seed * 7919 + slot, w));
+    }
+    pool.parallelFor(keys.size(), [&](std::size_t i, unsigned worker) {
+      std::array<int, 2> hole;
+      std::vector<int> board;
+      decodeSituation(keys[i], street, hole, board);
+      auto histogram = equityHistogram(hole, board, options.bins, options.runouts,
+                                       options.opponents, workerRngs[worker]);
+      std::copy(histogram.begin(), histogram.end(), histograms.begin() + i * options.bins);
+    });
+
+    auto &buckets = table.forStreet(street);
+    buckets.buckets = options.buckets[slot];
+    buckets.bins = options.bins;
+    cluster(histograms, buckets, options.iterations, pool, rng);
+    buckets.keys = std::move(keys);
+
+    auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "street " << street << ": " << buckets.buckets << " buckets in " << seconds << "s"
+              << std::endl;
+  }
+
+  auto directory = std::filesystem::path(options.out).parent_path();
+  if (!directory.empty()) {
+    std::filesystem::create_directories(directory);
+  }
+  if (!table.save(options.out)) {
+    std::cerr << "Unable to write " << options.out << std::endl;
+    return 1;
+  }
+  std::cout << "Wrote " << options.out << std::endl;
+  return 0;
+}
@@ -0,0 +1,257 @@
+/*
+  Load test of the runner and bot against a captured transcript.
+
+  Plays the engine's side of a transcript captured under POKERBOT_TRANSCRIPT
+  into a fresh Runner::run as fast as the bot answers, so parsing, state
+  updates and decisions are timed end to end without engine.py's overhead.
+  The runner reads either from a scripted stream buffer, which times the bot
+  alone, or from the other end of a transport driven by a thread playing the
+  engine: an in-process ring pair, or a Unix socket pair, which adds the
+  kernel round trip a real match pays.
+
+  Latency is measured from when a packet is available to the runner to when
+  its reply is complete, and reported next to the latency the transcript
+  recorded in the match. Replies that differ from the captured ones are
+  counted; with --resolve-iterations the resolver is deterministic, so these
+  point at behaviour changes rather than timing.
+
+  Usage:
+    harness --transcript match.bin [--transport stream|pipe|socket] [--repeat 1]
+            [--seed 1] [--resolve-iterations 20] [--verbose 0]
+*/
+#include "bot.h"
+
+#include <skeleton/log.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace pokerbots::skeleton;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  std::string transcript;
+  std::string transport = "stream";
+  int repeat = 1;
+  unsigned seed = 1;
+  int resolveIterations = 20;
+  bool verbose = false;
+};
+
+Options parseOptions(int argc, char *argv[]) {
+  Options options;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag(argv[i]);
+    std::string value(argv[i + 1]);
+    if (flag == "--transcript") {
+      options.transcript = value;
+    } else if (flag == "--transport") {
+      options.transport = value;
+    } else if (flag == "--repeat") {
+      options.repeat = std::stoi(value);
+    } else if (flag == "--seed") {
+      options.seed = static_cast<unsigned>(std::stoul(value));
+    } else if (flag == "--resolve-iterations") {
+      options.resolveIterations = std::stoi(value);
+    } else if (flag == "--verbose") {
+      options.verbose = std::stoi(value) != 0;
+    } else {
+      std::cerr << "unknown option " << flag << std::endl;
+    }
+  }
+  return options;
+}
+
+double millisSince(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// What one pass over the transcript produced.
+struct Pass {
+  std::vector<std::string> replies;
+  std::vector<double> latencies; // ms, one per reply
+  double seconds = 0;             // in Runner::run, without loading the bot
+};
+
+/*
+  The engine's side as a stream buffer: hands the runner one packet at a time,
+  like the engine only once the previous one has been answered, and collects
+  what it writes back line by line. The runner may read on another thread
+  than it writes, so the hand-over is guarded.
+*/
+class ScriptedBuffer : public std::streambuf {
+public:
+  ScriptedBuffer(const std::vector<std::string> &packets, Pass &pass) : packets(packets), pass(pass) {}
+
+protected:
+  int_type underflow() override {
+    std::unique_lock<std::mutex> lock(mutex);
+    answered.wait(lock, [&]() { return pass.replies.size() >= next; });
+    if (next == packets.size()) {
+      return traits_type::eof();
+    }
+    current = packets[next++] + '\n';
+    handedOut = Clock::now();
+    setg(current.data(), current.data(), current.data() + current.size());
+    return traits_type::to_int_type(current[0]);
+  }
+
+  int_type overflow(int_type c) override {
+    if (traits_type::eq_int_type(c, traits_type::eof())) {
+      return traits_type::not_eof(c);
+    }
+    if (traits_type::to_char_type(c) == '\n') {
+      std::lock_guard<std::mutex> lock(mutex);
+      pass.latencies.push_back(millisSince(handedOut));
+      pass.replies.push_back(pending);
+      pending.clear();
+      answered.notify_one();
+    } else {
+      pending += traits_type::to_char_type(c);
+    }
+    return c;
+  }
+
+private:
+  const std::vector<std::string> &packets;
+  Pass &pass;
+  std::size_t next = 0;
+  std::string current;
+  std::string pending;
+  Clock::time_point handedOut;
+  std::mutex mutex;
+  std::condition_variable answered;
+};
+
+void configure(Runner<Bot> &runner, const Options &options) {
+  runner.bot().fixedResolveIterations = options.resolveIterations;
+}
+
+Pass runInProcess(const std::vector<std::string> &packets, const Options &options) {
+  Pass pass;
+  ScriptedBuffer buffer(packets, pass);
+  std::iostream stream(&buffer);
+  Runner<Bot> runner(stream, options.seed);
+  configure(runner, options);
+  auto start = Clock::now();
+  runner.run();
+  pass.seconds = millisSince(start) / 1000;
+  return pass;
+}
+
+// Plays the engine on its own thread against a runner on the other end of a transport.
+Pass runConnected(std::pair<TransportPtr, TransportPtr> ends, const std::vector<std::string> &packets,
+                  const Options &options) {
+  auto &[botEnd, engineEnd] = ends;
+  Runner<Bot> runner(botEnd->stream(), options.seed);
+  configure(runner, options);
+
+  Pass pass;
+  std::thread engine([&]() {
+    auto &engineStream = engineEnd->stream();
+    std::string reply;
+    for (const auto &packet : packets) {
+      auto sent = Clock::now();
+      engineStream << packet + '\n';
+      if (packet == "Q" || !std::getline(engineStream, reply)) {
+        break;
+      }
+      pass.latencies.push_back(millisSince(sent));
+      pass.replies.push_back(reply);
+    }
+    // a transcript cut short has no Q, end of file ends the runner instead
+    engineEnd->close();
+  });
+  auto start = Clock::now();
+  runner.run();
+  engine.join();
+  pass.seconds = millisSince(start) / 1000;
+  return pass;
+}
+
+double percentile(std::vector<double> sorted, double p) {
+  if (sorted.empty()) {
+    return 0;
+  }
+  return sorted[std::min(sorted.size() - 1, static_cast<std::size_t>(p * sorted.size()))];
+}
+
+void reportLatencies(std::ostream &report, const std::string &label, std::vector<double> times) {
+  std::sort(times.begin(), times.end());
+  report << std::fixed << std::setprecision(3) << label << " ms: p50 " << percentile(times, 0.5) << " p90 "
+         << percentile(times, 0.9) << " p99 " << percentile(times, 0.99) << " max "
+         << (times.empty() ? 0 : times.back()) << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  auto options = parseOptions(argc, argv);
+  std::vector<TranscriptEntry> entries;
+  if (!readTranscript(options.transcript, entries)) {
+    std::cerr << "Unable to read transcript " << options.transcript << std::endl;
+    return 1;
+  }
+  if (options.transport != "stream" && options.transport != "pipe" && options.transport != "socket") {
+    std::cerr << "unknown transport " << options.transport << std::endl;
+    return 1;
+  }
+
+  std::vector<std::string> packets;
+  std::vector<std::string> captured;
+  std::vector<double> matchLatencies;
+  std::uint64_t received = 0;
+  for (const auto &entry : entries) {
+    if (entry.direction == TranscriptEntry::RECEIVED) {
+      packets.push_back(entry.line);
+      received = entry.nanoseconds;
+    } else {
+      captured.push_back(entry.line);
+      matchLatencies.push_back((entry.nanoseconds - received) / 1e6);
+    }
+  }
+
+  // the bot logs every decision; keep the report readable unless asked, and whole if asked
+  std::ostream &report = std::cout;
+  logger().setBudget(options.verbose ? std::numeric_limits<std::size_t>::max() / 2 : 0);
+
+  std::vector<double> latencies;
+  int divergences = 0;
+  double seconds = 0;
+  for (int r = 0; r < options.repeat; ++r) {
+    Pass pass;
+    if (options.transport == "pipe") {
+      pass = runConnected(inProcessPair(), packets, options);
+    } else if (options.transport == "socket") {
+      pass = runConnected(unixSocketPair(), packets, options);
+    } else {
+      pass = runInProcess(packets, options);
+    }
+    seconds += pass.seconds;
+    for (std::size_t i = 0; i < pass.replies.size() && i < captured.size(); ++i) {
+      divergences += pass.replies[i] != captured[i];
+    }
+    latencies.insert(latencies.end(), pass.latencies.begin(), pass.latencies.end());
+  }
+  logger().flush();
+
+  report << "Replayed " << packets.size() << " packets " << options.repeat << " times over " << options.transport
+         << " in " << std::setprecision(3) << seconds << "s (" << std::setprecision(0) << std::fixed
+         << latencies.size() / seconds << " replies/s), " << divergences << " replies differ from the capture"
+         << std::endl;
+  reportLatencies(report, "harness reply", latencies);
+  reportLatencies(report, "match reply  ", matchLatencies);
+  return 0;
+}
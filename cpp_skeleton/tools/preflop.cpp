@@ -0,0 +1,212 @@
+/*
+  Offline generator of the exact preflop all-in equity table.
+
+  Rather than running out 48 choose 5 boards for each of the ~800k matchups,
+  it walks the boards once. Boards that a relabelling of the suits maps onto
+  each other give the same results up to that relabelling, so only the
+  smallest board of each class is evaluated, for every live combo, and
+  weighted by the size of its class. Sorting is not needed: each combo's row
+  adds 2 for every combo it beats and 1 for every tie, a branch-free sweep
+  done for a block of boards at a time so the row stays in cache.
+
+  The sums over canonical boards are then averaged over the 24 relabellings,
+  which turns them back into exact counts over all boards, checked for being
+  whole and for the two sides of every matchup adding up. The table stores
+  one count per matchup class.
+
+  Usage:
+    preflop [--out data/preflop_equity.bin] [--threads 0]
+*/
+#include <skeleton/card_set.h>
+#include <skeleton/preflop_equity.h>
+#include <skeleton/thread_pool.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace pokerbots::skeleton;
+
+namespace {
+
+constexpr int BOARD_BLOCK = 16;
+
+struct Options {
+  std::string out = "data/preflop_equity.bin";
+  unsigned threads = 0;
+};
+
+Options parseOptions(int argc, char *argv[]) {
+  Options options;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag(argv[i]);
+    std::string value(argv[i + 1]);
+    if (flag == "--out") {
+      options.out = value;
+    } else if (flag == "--threads") {
+      options.threads = std::stoul(value);
+    } else {
+      std::cerr << "Unknown option " << flag << std::endl;
+    }
+  }
+  return options;
+}
+
+struct Board {
+  std::uint64_t cards;
+  std::uint32_t weight; // boards in its class
+};
+
+// The smallest board of every class of five-card boards under suit relabelling.
+std::vector<Board> canonicalBoards() {
+  std::array<std::array<int, NUM_CARDS>, NUM_SUIT_PERMUTATIONS> relabel;
+  std::array<int, NUM_SUITS> suits = {0, 1, 2, 3};
+  for (auto &permutation : relabel) {
+    for (int card = 0; card < NUM_CARDS; ++card) {
+      permutation[card] = cardIndex(rankOf(card), suits[suitOf(card)]);
+    }
+    std::next_permutation(suits.begin(), suits.end());
+  }
+
+  std::vector<Board> boards;
+  int c[5];
+  for (c[0] = 0; c[0] < NUM_CARDS; ++c[0])
+    for (c[1] = c[0] + 1; c[1] < NUM_CARDS; ++c[1])
+      for (c[2] = c[1] + 1; c[2] < NUM_CARDS; ++c[2])
+        for (c[3] = c[2] + 1; c[3] < NUM_CARDS; ++c[3])
+          for (c[4] = c[3] + 1; c[4] < NUM_CARDS; ++c[4]) {
+            auto cards = CardSet::of(c, 5).bits();
+            bool smallest = true;
+            std::uint32_t fixed = 0;
+            for (const auto &permutation : relabel) {
+              std::uint64_t image = 0;
+              for (int card : c) {
+                image |= 1ULL << permutation[card];
+              }
+              smallest = smallest && image >= cards;
+              fixed += image == cards;
+            }
+            if (smallest) {
+              boards.push_back({cards, NUM_SUIT_PERMUTATIONS / fixed});
+            }
+          }
+  return boards;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  auto options = parseOptions(argc, argv);
+  auto start = std::chrono::steady_clock::now();
+  auto seconds = [&]() { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); };
+
+  auto boards = canonicalBoards();
+  std::uint64_t total = 0;
+  for (const auto &board : boards) {
+    total += board.weight;
+  }
+  std::cout << boards.size() << " canonical boards standing for " << total << " in " << seconds() << "s"
+            << std::endl;
+
+  ThreadPool pool(options.threads);
+  // per worker: 2 * wins + ties of row combo against column combo, summed over canonical boards by weight
+  std::vector<std::vector<std::uint32_t>> sums(pool.size(),
+                                               std::vector<std::uint32_t>(static_cast<std::size_t>(NUM_COMBOS) * NUM_COMBOS));
+  std::size_t blocks = (boards.size() + BOARD_BLOCK - 1) / BOARD_BLOCK;
+  pool.parallelFor(blocks, [&](std::size_t block, unsigned worker) {
+    // a combo that touches the board has value 0, which neither beats nor ties a real hand
+    std::uint32_t values[BOARD_BLOCK][NUM_COMBOS];
+    std::uint32_t weights[BOARD_BLOCK];
+    int n = 0;
+    for (auto i = block * BOARD_BLOCK; i < boards.size() && n < BOARD_BLOCK; ++i, ++n) {
+      auto board = CardSet(boards[i].cards);
+      int cards[7];
+      board.indices(cards + 2);
+      weights[n] = boards[i].weight;
+      for (int combo = 0; combo < NUM_COMBOS; ++combo) {
+        if (comboSet(combo).intersects(board)) {
+          values[n][combo] = 0;
+          continue;
+        }
+        cards[0] = COMBO_CARDS[combo].first;
+        cards[1] = COMBO_CARDS[combo].second;
+        values[n][combo] = evalIndices(cards, 7);
+      }
+    }
+    auto &sum = sums[worker];
+    for (int a = 0; a < NUM_COMBOS; ++a) {
+      std::uint32_t *row = &sum[static_cast<std::size_t>(a) * NUM_COMBOS];
+      for (int k = 0; k < n; ++k) {
+        auto ours = values[k][a];
+        if (ours == 0) {
+          continue;
+        }
+        auto weight = weights[k];
+        const std::uint32_t *theirs = values[k];
+        for (int b = 0; b < NUM_COMBOS; ++b) {
+          // lower values are better hands
+          row[b] += weight * ((ours < theirs[b]) + (ours <= theirs[b]));
+        }
+      }
+    }
+  });
+  for (std::size_t w = 1; w < sums.size(); ++w) {
+    for (std::size_t i = 0; i < sums[0].size(); ++i) {
+      sums[0][i] += sums[w][i];
+    }
+  }
+  const auto &sum = sums[0];
+  std::cout << "Evaluated every live combo on each canonical board in " << seconds() << "s" << std::endl;
+
+  const auto &permutations = comboPermutations();
+  auto count = [&](int a, int b) {
+    std::uint64_t counted = 0;
+    for (const auto &permutation : permutations) {
+      counted += sum[static_cast<std::size_t>(permutation[a]) * NUM_COMBOS + permutation[b]];
+    }
+    return counted;
+  };
+  std::vector<std::uint32_t> keys;
+  std::vector<std::uint32_t> counts;
+  int inconsistent = 0;
+  for (int a = 0; a < NUM_COMBOS; ++a) {
+    for (int b = 0; b < NUM_COMBOS; ++b) {
+      if (comboSet(a).intersects(comboSet(b))) {
+        continue;
+      }
+      bool swapped = false;
+      if (canonicalMatchup(a, b, swapped) != static_cast<std::uint32_t>(a * NUM_COMBOS + b)) {
+        continue;
+      }
+      auto ours = count(a, b);
+      auto theirs = count(b, a);
+      inconsistent += ours % NUM_SUIT_PERMUTATIONS != 0 ||
+                      ours + theirs != 2ULL * NUM_SUIT_PERMUTATIONS * PREFLOP_BOARDS;
+      keys.push_back(static_cast<std::uint32_t>(a * NUM_COMBOS + b));
+      counts.push_back(static_cast<std::uint32_t>(ours / NUM_SUIT_PERMUTATIONS));
+    }
+  }
+  if (inconsistent > 0) {
+    std::cerr << inconsistent << " matchup classes do not add up" << std::endl;
+    return 1;
+  }
+
+  PreflopEquity table;
+  table.assign(std::move(keys), std::move(counts));
+  auto directory = std::filesystem::path(options.out).parent_path();
+  if (!directory.empty()) {
+    std::filesystem::create_directories(directory);
+  }
+  if (!table.save(options.out)) {
+    std::cerr << "Unable to write " << options.out << std::endl;
+    return 1;
+  }
+  std::cout << "Wrote " << table.numClasses() << " matchup classes to " << options.out << " in " << seconds()
+            << "s; AA vs KK " << table.equity(comboIndex(cardIndex(12, 0), cardIndex(12, 1)),
+                                               comboIndex(cardIndex(11, 2), cardIndex(11, 3)))
+            << std::endl;
+  return 0;
+}
@@ -0,0 +1,366 @@
+/*
+  Offline replay of a match through the bot.
+
+  Reads an engine gamelog, a transcript with one engine packet per line, or a
+  binary transcript captured with POKERBOT_TRANSCRIPT, rebuilds the packets the engine sent to one player and feeds them to the bot
+  through Runner::handlePacket, with no engine or socket involved. Every reply
+  that differs from the action in the log is reported, followed by the time
+  the bot spent per decision.
+
+  The bot's random streams are seeded from --seed, and with
+  --resolve-iterations the turn and river resolver stops after a fixed number
+  of iterations instead of against the clock, so two runs with the same
+  options make the same decisions. The game clock is held at --clock, since
+  logs do not record it.
+
+  Usage:
+    replay --log gamelog.txt [--player A] [--seed 1] [--clock 60]
+           [--resolve-iterations 20] [--verbose 0]
+*/
+#include "bot.h"
+
+#include <skeleton/log.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace pokerbots::skeleton;
+
+namespace {
+
+const std::string GAMELOG_HEADER = "6.9630 MIT Pokerbots - ";
+
+struct Options {
+  std::string log;
+  std::string player;
+  unsigned seed = 1;
+  double clock = 60;
+  int resolveIterations = 20;
+  bool verbose = false;
+};
+
+// A packet as the engine sent it, and for decisions the action the log says followed.
+struct Packet {
+  std::string line;
+  std::string expected;
+};
+
+Options parseOptions(int argc, char *argv[]) {
+  Options options;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag(argv[i]);
+    std::string value(argv[i + 1]);
+    if (flag == "--log") {
+      options.log = value;
+    } else if (flag == "--player") {
+      options.player = value;
+    } else if (flag == "--seed") {
+      options.seed = static_cast<unsigned>(std::stoul(value));
+    } else if (flag == "--clock") {
+      options.clock = std::stod(value);
+    } else if (flag == "--resolve-iterations") {
+      options.resolveIterations = std::stoi(value);
+    } else if (flag == "--verbose") {
+      options.verbose = std::stoi(value) != 0;
+    } else {
+      std::cerr << "unknown option " << flag << std::endl;
+    }
+  }
+  return options;
+}
+
+bool startsWith(const std::string &s, const std::string &prefix) { return s.compare(0, prefix.size(), prefix) == 0; }
+
+// "[Ah Kd]" -> {"Ah", "Kd"}
+std::vector<std::string> parseCards(const std::string &s) {
+  std::vector<std::string> cards;
+  auto open = s.find('[');
+  auto close = s.find(']', open);
+  if (open == std::string::npos || close == std::string::npos) {
+    return cards;
+  }
+  std::stringstream ss(s.substr(open + 1, close - open - 1));
+  std::string card;
+  while (ss >> card) {
+    cards.push_back(card);
+  }
+  return cards;
+}
+
+std::string joinCards(const std::vector<std::string> &cards) {
+  std::string joined;
+  for (const auto &card : cards) {
+    joined += (joined.empty() ? "" : ",") + card;
+  }
+  return joined;
+}
+
+/*
+  Rebuilds what the engine sent `player`: clauses pile up as the round goes on
+  and are flushed as one packet whenever the player is asked to act and once
+  more when the round ends, as in Game.run_round.
+*/
+std::vector<Packet> packetsFromGamelog(std::istream &in, std::string &player, double clock) {
+  std::vector<Packet> packets;
+  std::string line;
+  std::getline(in, line);
+  if (player.empty()) {
+    auto names = line.substr(GAMELOG_HEADER.size());
+    player = names.substr(0, names.find(" vs "));
+  }
+
+  std::ostringstream time;
+  time << 'T' << std::fixed << std::setprecision(3) << clock;
+  std::vector<std::string> message;
+  std::map<std::string, char> bounties;
+  std::map<std::string, std::vector<std::string>> hands;
+  std::vector<std::string> board;
+  int seat = 0;
+  int delta = 0;
+
+  auto flush = [&](const std::string &expected) {
+    std::string packet = time.str();
+    for (const auto &clause : message) {
+      packet += ' ' + clause;
+    }
+    packets.push_back({packet, expected});
+    message.clear();
+  };
+  auto action = [&](const std::string &name, const std::string &code) {
+    if (name == player) {
+      flush(code);
+    }
+    message.push_back(code);
+  };
+
+  while (std::getline(in, line)) {
+    if (startsWith(line, "Round #")) {
+      auto first = line.find(", ") + 2;
+      seat = line.compare(first, player.size() + 2, player + " (") == 0 ? 0 : 1;
+      message = {"P" + std::to_string(seat)};
+      hands.clear();
+      board.clear();
+    } else if (startsWith(line, "Bounties reset to ")) {
+      // "Bounties reset to 6 for player A and K for player B"
+      std::stringstream ss(line.substr(18));
+      std::string rank, word, name;
+      ss >> rank >> word >> word >> name;
+      bounties[name] = rank[0];
+      ss >> word >> rank >> word >> word >> name;
+      bounties[name] = rank[0];
+    } else if (startsWith(line, "Flop [") || startsWith(line, "Turn [") || startsWith(line, "River [")) {
+      board = parseCards(line);
+      message.push_back("B" + joinCards(board));
+    } else if (startsWith(line, "Winning counts at the end of the round")) {
+      // the loser's bounty is masked, as the engine does
+      auto hit = [&](const std::string &name) {
+        const auto &hole = hands[name];
+        auto has = [&](const std::string &card) { return !card.empty() && card[0] == bounties[name]; };
+        return std::any_of(hole.begin(), hole.end(), has) || std::any_of(board.begin(), board.end(), has);
+      };
+      std::string opponent;
+      for (const auto &entry : hands) {
+        if (entry.first != player) {
+          opponent = entry.first;
+        }
+      }
+      char own = delta < 0 ? '#' : (hit(player) ? '1' : '0');
+      char theirs = delta > 0 ? '#' : (hit(opponent) ? '1' : '0');
+      message.push_back(std::string("Y") + own + theirs);
+      flush("");
+    } else if (startsWith(line, "Final")) {
+      packets.push_back({"Q", ""});
+    } else {
+      auto space = line.find(' ');
+      if (space == std::string::npos) {
+        continue;
+      }
+      auto name = line.substr(0, space);
+      auto rest = line.substr(space + 1);
+      if (startsWith(rest, "dealt ")) {
+        hands[name] = parseCards(rest);
+        if (name == player) {
+          message.push_back("H" + joinCards(hands[name]));
+          message.push_back(std::string("G") + bounties[name]);
+        }
+      } else if (rest == "folds") {
+        action(name, "F");
+      } else if (rest == "calls") {
+        action(name, "C");
+      } else if (rest == "checks") {
+        action(name, "K");
+      } else if (startsWith(rest, "bets ")) {
+        action(name, "R" + rest.substr(5));
+      } else if (startsWith(rest, "raises to ")) {
+        action(name, "R" + rest.substr(10));
+      } else if (startsWith(rest, "shows ") && name != player) {
+        message.push_back("O" + joinCards(parseCards(rest)));
+      } else if (startsWith(rest, "awarded ") && name == player) {
+        delta = std::stoi(rest.substr(8));
+        message.push_back("D" + rest.substr(8));
+      }
+    }
+  }
+  return packets;
+}
+
+// A transcript has the packets already; what we did is the first action in the packet after a decision.
+std::vector<Packet> packetsFromTranscript(std::istream &in) {
+  std::vector<Packet> packets;
+  std::string line;
+  while (std::getline(in, line)) {
+    if (!line.empty()) {
+      packets.push_back({line, ""});
+    }
+  }
+  for (std::size_t i = 0; i + 1 < packets.size(); ++i) {
+    std::stringstream ss(packets[i + 1].line);
+    std::string clause;
+    while (ss >> clause) {
+      if (clause[0] == 'F' || clause[0] == 'C' || clause[0] == 'K' || clause[0] == 'R') {
+        packets[i].expected = clause;
+        break;
+      }
+      if (clause[0] != 'T') {
+        break;
+      }
+    }
+  }
+  return packets;
+}
+
+// A captured transcript has both sides; the reply to a packet is the entry after it.
+std::vector<Packet> packetsFromCapture(const std::vector<TranscriptEntry> &entries) {
+  std::vector<Packet> packets;
+  for (const auto &entry : entries) {
+    if (entry.direction == TranscriptEntry::RECEIVED) {
+      packets.push_back({entry.line, ""});
+    } else if (!packets.empty()) {
+      packets.back().expected = entry.line;
+    }
+  }
+  return packets;
+}
+
+// What the engine makes of a reply: illegal actions become a check, or a fold if checking is not allowed.
+Action asApplied(const Action &action, const RoundState &state) {
+  auto legal = state.legalActions();
+  if (legal.count(action.actionType)) {
+    if (action.actionType != Action::Type::RAISE) {
+      return action;
+    }
+    auto bounds = state.raiseBounds();
+    if (bounds[0] <= action.amount && action.amount <= bounds[1]) {
+      return action;
+    }
+  }
+  return {legal.count(Action::Type::CHECK) ? Action::Type::CHECK : Action::Type::FOLD};
+}
+
+std::string encode(const Action &action) {
+  std::ostringstream os;
+  os << action;
+  return os.str();
+}
+
+double percentile(std::vector<double> sorted, double p) {
+  if (sorted.empty()) {
+    return 0;
+  }
+  return sorted[std::min(sorted.size() - 1, static_cast<std::size_t>(p * sorted.size()))];
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  auto options = parseOptions(argc, argv);
+  std::ifstream in(options.log);
+  if (!in) {
+    std::cerr << "Unable to read " << options.log << std::endl;
+    return 1;
+  }
+  std::string first;
+  std::getline(in, first);
+  in.seekg(0);
+  bool gamelog = startsWith(first, GAMELOG_HEADER);
+  std::vector<TranscriptEntry> captured;
+  std::vector<Packet> packets;
+  if (gamelog) {
+    packets = packetsFromGamelog(in, options.player, options.clock);
+  } else if (readTranscript(options.log, captured)) {
+    packets = packetsFromCapture(captured);
+  } else {
+    packets = packetsFromTranscript(in);
+  }
+
+  // the bot logs every decision; keep the report readable unless asked, and whole if asked
+  std::ostream &report = std::cout;
+  logger().setBudget(options.verbose ? std::numeric_limits<std::size_t>::max() / 2 : 0);
+
+  std::stringstream unused;
+  Runner<Bot> runner(unused, options.seed);
+  runner.bot().fixedResolveIterations = options.resolveIterations;
+
+  static const char *STREET_NAMES[] = {"preflop", "", "", "flop", "turn", "river"};
+  std::vector<double> times;
+  std::array<std::vector<double>, 6> streetTimes;
+  int rounds = 0;
+  int street = 0;
+  int divergences = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (const auto &packet : packets) {
+    auto clauses = Runner<Bot>::splitPacket(packet.line);
+    for (const auto &clause : clauses) {
+      if (clause[0] == 'H') {
+        ++rounds;
+        street = 0;
+      } else if (clause[0] == 'B') {
+        street = static_cast<int>(std::count(clause.begin(), clause.end(), ',')) + 1;
+      }
+    }
+
+    auto before = std::chrono::steady_clock::now();
+    auto reply = runner.handlePacket(clauses);
+    auto millis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - before).count();
+    if (!reply) {
+      break;
+    }
+    if (!runner.inRound()) {
+      continue;
+    }
+    times.push_back(millis);
+    streetTimes[street].push_back(millis);
+    auto played = encode(asApplied(*reply, static_cast<const RoundState &>(*runner.state())));
+    if (!packet.expected.empty() && played != packet.expected) {
+      ++divergences;
+      report << "round " << rounds << " " << STREET_NAMES[street] << ": log has " << packet.expected
+             << ", bot played " << played << std::endl;
+    }
+  }
+  auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  logger().flush();
+
+  report << "Replayed " << rounds << " rounds as " << (gamelog ? options.player : "the transcript's player")
+         << " in " << seconds << "s: " << times.size() << " decisions, " << divergences << " divergences"
+         << std::endl;
+  std::sort(times.begin(), times.end());
+  report << std::fixed << std::setprecision(3) << "decision ms: p50 " << percentile(times, 0.5) << " p90 "
+         << percentile(times, 0.9) << " p99 " << percentile(times, 0.99) << " max "
+         << (times.empty() ? 0 : times.back()) << std::endl;
+  for (int s : {0, 3, 4, 5}) {
+    auto &t = streetTimes[s];
+    std::sort(t.begin(), t.end());
+    report << "  " << STREET_NAMES[s] << ": " << t.size() << " decisions, p50 " << percentile(t, 0.5) << " max "
+           << (t.empty() ? 0 : t.back()) << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,171 @@
+/*
+  Variance of sampleFeatures under each Sampling strategy.
+
+  For random situations on each postflop street it estimates the features
+  many times from independent seeds, at the sample size the bot uses, and
+  reports the spread of the equity and EHS^2 estimates across repeats next
+  to the time one estimate takes. Standard errors fall with the square root
+  of the sample size, so the runouts and time a strategy needs to reach a
+  target standard error follow from both, which is how the bot's strategy
+  is chosen: the cheapest one to reach the target.
+
+  Usage:
+    sampling [--situations 200] [--repeats 40] [--runouts 100] [--opponents 6]
+             [--target 0.01] [--seed 1]
+*/
+#include <skeleton/card_set.h>
+#include <skeleton/features.h>
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace pokerbots::skeleton;
+
+namespace {
+
+struct Options {
+  int situations = 200;
+  int repeats = 40;
+  int runouts = 100;
+  int opponents = 6;
+  double target = 0.01;
+  std::uint64_t seed = 1;
+};
+
+Options parseOptions(int argc, char *argv[]) {
+  Options options;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag(argv[i]);
+    std::string value(argv[i + 1]);
+    if (flag == "--situations") {
+      options.situations = std::stoi(value);
+    } else if (flag == "--repeats") {
+      options.repeats = std::stoi(value);
+    } else if (flag == "--runouts") {
+      options.runouts = std::stoi(value);
+    } else if (flag == "--opponents") {
+      options.opponents = std::stoi(value);
+    } else if (flag == "--target") {
+      options.target = std::stod(value);
+    } else if (flag == "--seed") {
+      options.seed = std::stoull(value);
+    } else {
+      std::cerr << "unknown option " << flag << std::endl;
+    }
+  }
+  return options;
+}
+
+struct Situation {
+  std::array<int, 2> hole;
+  std::vector<int> board;
+  int bountyRank;
+};
+
+struct Strategy {
+  Sampling sampling;
+  const char *name;
+};
+
+constexpr Strategy STRATEGIES[] = {
+    {Sampling::RANDOM, "random"},
+    {Sampling::STRATIFIED, "stratified"},
+    {Sampling::QUASI_RANDOM, "sobol"},
+    {Sampling::ANTITHETIC, "antithetic"},
+};
+
+// Within-situation variance of the estimates, averaged over situations, and the time per estimate.
+struct Measurement {
+  double equityVariance = 0;
+  double ehs2Variance = 0;
+  double microseconds = 0;
+};
+
+double variance(const std::vector<double> &xs) {
+  double mean = 0;
+  for (auto x : xs) {
+    mean += x;
+  }
+  mean /= xs.size();
+  double squares = 0;
+  for (auto x : xs) {
+    squares += (x - mean) * (x - mean);
+  }
+  return squares / (xs.size() - 1);
+}
+
+Measurement measure(const std::vector<Situation> &situations, Sampling sampling, const Options &options) {
+  Measurement measurement;
+  std::vector<double> equities(options.repeats);
+  std::vector<double> ehs2s(options.repeats);
+  double seconds = 0;
+  for (std::size_t s = 0; s < situations.size(); ++s) {
+    const auto &situation = situations[s];
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < options.repeats; ++r) {
+      auto rng = Rng::stream(options.seed + 1, s * options.repeats + r);
+      auto features = sampleFeatures(situation.hole, situation.board, situation.bountyRank, options.runouts,
+                                     options.opponents, rng, sampling)
+                          .finish();
+      equities[r] = features.equity;
+      ehs2s[r] = features.ehs2;
+    }
+    seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    measurement.equityVariance += variance(equities) / situations.size();
+    measurement.ehs2Variance += variance(ehs2s) / situations.size();
+  }
+  measurement.microseconds = seconds * 1e6 / (situations.size() * options.repeats);
+  return measurement;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  auto options = parseOptions(argc, argv);
+  if (options.repeats < 2 || options.opponents < 4 || options.opponents % 2 != 0) {
+    std::cerr << "need at least two repeats and an even number of at least four opponents" << std::endl;
+    return 1;
+  }
+  Rng rng(options.seed);
+
+  std::cout << std::fixed << options.runouts << " runouts x " << options.opponents << " opponents, "
+            << options.situations << " situations x " << options.repeats << " repeats per street, target "
+            << std::setprecision(4) << options.target << std::endl;
+  for (int boardSize : {3, 4, 5}) {
+    std::vector<Situation> situations(options.situations);
+    for (auto &situation : situations) {
+      auto live = CardSet::deck();
+      situation.hole[0] = live.sample(rng);
+      live.remove(situation.hole[0]);
+      situation.hole[1] = live.sample(rng);
+      live.remove(situation.hole[1]);
+      for (int i = 0; i < boardSize; ++i) {
+        situation.board.push_back(live.sample(rng));
+        live.remove(situation.board.back());
+      }
+      situation.bountyRank = static_cast<int>(rng.below(NUM_RANKS));
+    }
+
+    std::cout << "board of " << boardSize << std::endl;
+    Measurement baseline;
+    for (const auto &strategy : STRATEGIES) {
+      auto m = measure(situations, strategy.sampling, options);
+      if (strategy.sampling == Sampling::RANDOM) {
+        baseline = m;
+      }
+      // the runouts and time the estimate needs for the equity's standard error to reach the target
+      double scale = m.equityVariance / (options.target * options.target);
+      std::cout << std::setw(12) << strategy.name << std::setprecision(5) << "  equity sd "
+                << std::sqrt(m.equityVariance) << "  ehs2 sd " << std::sqrt(m.ehs2Variance)
+                << std::setprecision(2) << "  variance x" << m.equityVariance / baseline.equityVariance
+                << std::setprecision(1) << "  " << m.microseconds << "us per estimate  runouts to target "
+                << std::ceil(options.runouts * scale) << " in " << m.microseconds * scale << "us" << std::endl;
+    }
+  }
+  return 0;
+}
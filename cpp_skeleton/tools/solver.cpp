@@ -0,0 +1,140 @@
+/*
+  Offline blueprint solver.
+
+  Runs external-sampling MCCFR on the abstract bounty hold'em game and writes the
+  average strategy as a StrategyTable. Progress is checkpointed periodically so a
+  long run can be stopped and resumed with --resume.
+
+  Usage:
+    solver [--out data/strategy.bin] [--buckets data/buckets.bin] [--fractions 0.5,1]
+           [--allin 1] [--max-raises 3] [--fallback-buckets 50] [--iterations 1000000]
+           [--threads 0] [--seed 1] [--checkpoint-every 100000]
+           [--checkpoint data/solver.ckpt] [--resume 0]
+
+  Streets missing from the bucket file (or all of them, if it does not exist) use
+  the fallback abstraction described in skeleton/cfr.h.
+*/
+#include <skeleton/buckets.h>
+#include <skeleton/cfr.h>
+#include <skeleton/game_tree.h>
+#include <skeleton/thread_pool.h>
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace pokerbots::skeleton;
+
+namespace {
+
+struct Options {
+  std::string out = "data/strategy.bin";
+  std::string buckets = "data/buckets.bin";
+  std::string checkpoint = "data/solver.ckpt";
+  BetAbstraction bets;
+  int fallbackBuckets = 50;
+  std::uint64_t iterations = 1000000;
+  std::uint64_t checkpointEvery = 100000;
+  unsigned threads = 0;
+  unsigned seed = 1;
+  bool resume = false;
+};
+
+std::vector<double> parseFractions(const std::string &arg) {
+  std::vector<double> values;
+  std::stringstream ss(arg);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    values.push_back(std::stod(item));
+  }
+  return values;
+}
+
+Options parseOptions(int argc, char *argv[]) {
+  Options options;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag(argv[i]);
+    std::string value(argv[i + 1]);
+    if (flag == "--out") {
+      options.out = value;
+    } else if (flag == "--buckets") {
+      options.buckets = value;
+    } else if (flag == "--fractions") {
+      options.bets.potFractions = parseFractions(value);
+    } else if (flag == "--allin") {
+      options.bets.allIn = std::stoi(value) != 0;
+    } else if (flag == "--max-raises") {
+      options.bets.maxRaisesPerStreet = std::stoi(value);
+    } else if (flag == "--fallback-buckets") {
+      options.fallbackBuckets = std::stoi(value);
+    } else if (flag == "--iterations") {
+      options.iterations = std::stoull(value);
+    } else if (flag == "--threads") {
+      options.threads = static_cast<unsigned>(std::stoul(value));
+    } else if (flag == "--seed") {
+      options.seed = static_cast<unsigned>(std::stoul(value));
+    } else if (flag == "--checkpoint-every") {
+      options.checkpointEvery = std::stoull(value);
+    } else if (flag == "--checkpoint") {
+      options.checkpoint = value;
+    } else if (flag == "--resume") {
+      options.resume = std::stoi(value) != 0;
+    } else {
+      std::cerr << "unknown option " << flag << std::endl;
+    }
+  }
+  return options;
+}
+
+void createParent(const std::string &path) {
+  auto directory = std::filesystem::path(path).parent_path();
+  if (!directory.empty()) {
+    std::filesystem::create_directories(directory);
+  }
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  auto options = parseOptions(argc, argv);
+  ThreadPool pool(options.threads);
+
+  BucketTable table;
+  bool haveBuckets = table.load(options.buckets);
+  std::cout << (haveBuckets ? "Loaded " : "No bucket table at ") << options.buckets << std::endl;
+  CardAbstraction cards(haveBuckets ? &table : nullptr, options.fallbackBuckets);
+
+  GameTree tree(options.bets);
+  Solver solver(tree, cards);
+  std::cout << "Tree has " << tree.size() << " nodes" << std::endl;
+
+  if (options.resume) {
+    if (solver.loadCheckpoint(options.checkpoint)) {
+      std::cout << "Resumed at iteration " << solver.iterations() << std::endl;
+    } else {
+      std::cerr << "No compatible checkpoint at " << options.checkpoint << ", starting over" << std::endl;
+    }
+  }
+
+  createParent(options.out);
+  createParent(options.checkpoint);
+  auto start = std::chrono::steady_clock::now();
+  solver.run(options.iterations, pool, options.seed, options.checkpointEvery, options.checkpoint);
+  auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::cout << options.iterations << " iterations in " << seconds << "s" << std::endl;
+  if (haveBuckets) {
+    auto stats = table.fallbackStats();
+    std::cout << "Situations missing from the bucket table: " << stats.misses << " sampled, " << stats.hits
+              << " cached (" << 100 * stats.hitRate() << "% hits)" << std::endl;
+  }
+
+  if (!solver.exportStrategy(options.out)) {
+    std::cerr << "Unable to write " << options.out << std::endl;
+    return 1;
+  }
+  std::cout << "Wrote " << options.out << std::endl;
+  return 0;
+}